@@ -1,13 +1,24 @@
 #pragma once
 
+#include "bit_board.hpp"
 #include "board.hpp"
+#include "endgame_solver.hpp"
 #include "io_util.hpp"
 #include "monte_carlo.hpp"
 #include "referee.hpp"
+#include "value_function.hpp"
 
 #include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
 #include <iostream>
 #include <random>
+#include <string>
+
+#if __has_include(<sys/resource.h>)
+#include <sys/resource.h>
+#endif
 
 namespace entropy {
 
@@ -101,29 +112,388 @@ inline void benchmark_rng() {
  *
  */
 
-template <std::size_t ROLLOUTS = 5'000, std::size_t N = 200>
-inline void benchmark_mcts_ponder() {
-    using namespace mcts;
+// Peak resident set size of the process in KiB, 0 where it cannot be queried
+inline long peak_rss_kib() {
+#if __has_include(<sys/resource.h>)
+    rusage usage{};
+    if (!getrusage(RUSAGE_SELF, &usage)) return usage.ru_maxrss;
+#endif
+    return 0;
+}
+
+// Deterministic midgame-like position with `chips` randomly placed chips.
+inline std::pair<BoardState, ChipPool> create_benchmark_position(uint chips = 15) {
     FastRand rand{0};
     BoardState b;
     ChipPool pool;
     RandomMoveMaker rando{1};
-    for (uint i = 0; i < 15; ++i) {
+    for (uint i = 0; i < chips; ++i) {
         Colour c = pool.random_chip(rand);
         pool = ChipPool(pool, c);
         auto m = rando.suggest_chaos_move(c);
         b.place_chip(m);
         rando.register_chaos_move(m);
     }
+    return {b, pool};
+}
 
-    {
+/*
+ * N=20, 5000 rollouts, release build
+ *
+ * shared_ptr nodes in PreallocatedBuffer:
+ * 6983ms - 7366ms, ~14.5k nodes/s, peak RSS 20220KiB
+ *
+ * NodeArena, children as index vectors:
+ * 6808ms - 7628ms, 13.2k - 14.8k nodes/s, peak RSS 18400KiB - 18550KiB
+ *
+ * NodeArena, unvisited moves in arrays (OrderNode 1424 B, ChaosEdges 504 B):
+ * 5074ms - 5529ms, 17.5k - 19.0k nodes/s, peak RSS 14604KiB - 14844KiB
+ *
+ * unvisited moves in bitsets (OrderNode 1232 B, ChaosEdges 456 B):
+ * 5139ms - 5447ms, 17.7k - 18.8k nodes/s, peak RSS 14244KiB - 14328KiB
+ *
+ * EdgeStatistics (OrderNode 2336 B, ChaosEdges 960 B):
+ * 5192ms - 5509ms, 17.6k - 18.6k nodes/s, peak RSS 17652KiB - 17772KiB
+ */
+template <std::size_t ROLLOUTS = 5'000, std::size_t N = 200>
+inline void benchmark_mcts_ponder() {
+    using namespace mcts;
+    auto [b, pool] = create_benchmark_position();
+
+    mcts::RNG.seed = 0;
+
+    SearchEnvironment env{.45, ROLLOUTS};
+    std::size_t nodes = 0;
+
+    const auto begin = Clock::now();
+    for (uint i = 0; i < N; ++i) {
+        env.tree_search_chaos(env.chaos_node(env.chaos_arena->create(b, pool)), 1);
+
+        nodes += env.order_arena->live_nodes() + env.chaos_arena->live_nodes();
+        env.reset();
+    }
+    const double millis = millis_between(begin, Clock::now());
+
+    std::cerr << "Monte Carlo tree search ponder: " << millis << "ms, " << nodes << " nodes, "
+              << double(nodes) / millis * 1000 << " nodes/s, peak RSS " << peak_rss_kib() << "KiB\n";
+}
+
+template <std::size_t ROLLOUTS = 20'000>
+inline void benchmark_parallel_mcts(mcts::Parallelism parallelism) {
+    using namespace mcts;
+    auto [b, pool] = create_benchmark_position();
+
+    for (uint threads : {1, 2, 4, 8, 16}) {
         mcts::RNG.seed = 0;
 
-        SearchEnvironment env{.45, ROLLOUTS};
-        Timer t("Monte Carlo tree search ponder");
-        for (uint i = 0; i < N; ++i) {
-            ChaosNode node(b, pool);
-            env.tree_search_chaos(node, 1);
+        SearchEnvironment env{.45, ROLLOUTS, Clock::time_point::max(), threads, parallelism};
+        auto &node = env.chaos_node(env.chaos_arena->create(b, pool));
+
+        const auto begin = Clock::now();
+        env.tree_search_chaos(node, 1);
+        const double millis = millis_between(begin, Clock::now());
+
+        std::cerr << (parallelism == Parallelism::ROOT ? "Root" : "Tree") << " parallel MCTS with " << threads << " threads: "
+                  << millis << "ms, " << node.get_total_visits() / millis * 1000 << " rollouts/s\n";
+    }
+}
+
+/*
+ * 32 roots with 47 children for each of the 7 colours, 100 rollouts per colour, release build
+ *
+ * UCT scores from the child nodes: 486 - 500 ns per selection
+ * EdgeStatistics, one scalar loop: 294 - 374 ns per selection
+ * EdgeStatistics, vectorized score loop and VISITS_TABLE: 272 - 291 ns per selection
+ *
+ * Measured again in one later session: 88 - 102 ns per selection before RAVE. 180 - 196 ns with the RAVE blend in the
+ * score loop, whose branches stopped the vectorization. 99 - 119 ns with RAVE in an instantiation of its own and its
+ * weight from VISITS_TABLE, 138 - 166 ns with RAVE on.
+ */
+template <std::size_t ROLLOUTS = 100, std::size_t N = 2'000'000>
+inline void benchmark_uct_selection() {
+    using namespace mcts;
+    constexpr uint ROOTS = 32;
+    auto [b, pool] = create_benchmark_position(1);
+
+    mcts::RNG.seed = 0;
+
+    SearchEnvironment env{.45, ROLLOUTS};
+    std::vector<ChaosNode *> roots;
+    b.get_minimal_state().for_each_empty_space([&, &b = b, &pool = pool](Position p) {
+        if (roots.size() == ROOTS) return;
+
+        const Colour c = Colour(1 + roots.size() % ChipPool::N);
+        BoardState root_board = b;
+        root_board.place_chip({p, c});
+        auto &root = env.chaos_node(env.chaos_arena->create(root_board, ChipPool(pool, c)));
+        for (Colour colour = 1; colour <= ChipPool::N; ++colour) env.tree_search_chaos(root, colour);
+        roots.push_back(&root);
+    });
+
+    std::size_t check = 0;
+    const auto begin = Clock::now();
+    for (std::size_t i = 0; i < N; ++i) check += roots[i % ROOTS]->select_edge(Colour(1 + i / ROOTS % ChipPool::N), env);
+    const double millis = millis_between(begin, Clock::now());
+
+    std::cerr << "UCT selection: " << millis * 1e6 / N << "ns per selection, " << env.order_arena->live_nodes()
+              << " children (" << check << ")\n";
+}
+
+/*
+ * Benchmark position with the given open cells, fresh solver, release build. The first probe allocates and clears the
+ * 8 MiB table, 5 - 8ms of every time below.
+ *
+ * Plain expectimax:
+ * 3 open cells: order 8.3ms, 17.0k nodes; chaos 5.9ms, 1.0k nodes
+ * 4 open cells: order 192ms, 1.26M nodes; chaos 16.6ms, 66.5k nodes
+ * 5 open cells: order 85.7s, 558M nodes; chaos 627ms, 5.67M nodes
+ *
+ * Order moves cut off at the best placement so far, moves sorted by their immediate score:
+ * 3 open cells: order 9.8ms, 9.3k nodes; chaos 8.6ms, 0.6k nodes
+ * 4 open cells: order 224 - 421ms, 465k nodes; chaos 23.8 - 28.8ms, 22.6k nodes
+ * 5 open cells: order 42.0s, 85.6M nodes; chaos 787ms, 1.62M nodes
+ *
+ * Unsorted moves with the cutoff: 4 open cells: order 575 - 660ms, 941k nodes
+ */
+template <uint MAX_OPEN_CELLS = ENDGAME_OPEN_CELLS>
+inline void benchmark_endgame() {
+    for (uint open_cells = 1; open_cells <= MAX_OPEN_CELLS; ++open_cells) {
+        auto [b, pool] = create_benchmark_position(BOARD_AREA - open_cells);
+
+        // Fresh solvers, so that nothing is reused from the smaller thresholds
+        EndgameSolver order_solver;
+        auto begin = Clock::now();
+        const auto order = order_solver.solve_order(b, pool);
+        const double order_millis = millis_between(begin, Clock::now());
+
+        EndgameSolver chaos_solver;
+        begin = Clock::now();
+        const auto chaos = chaos_solver.solve_chaos(b, pool, 1);
+        const double chaos_millis = millis_between(begin, Clock::now());
+
+        std::cerr << "Endgame with " << open_cells << " open cells: order " << order_millis << "ms, "
+                  << order_solver.statistics.nodes << " nodes, " << order_solver.statistics.table_hits << " table hits, score "
+                  << order.score << "; chaos " << chaos_millis << "ms, " << chaos_solver.statistics.nodes << " nodes, "
+                  << chaos_solver.statistics.table_hits << " table hits, score " << chaos.score << '\n';
+    }
+}
+
+/*
+ * 3000 iterations, release build (the time includes the first touch of the arenas)
+ *
+ * chips  every child first                              progressive widening
+ *     5  chaos 10 - 13ms, 44 of 44 children, best 84     chaos 18 - 25ms, 44 of 44 children, best 92
+ *        order 17 - 18ms, 44 children, best 118          order 15ms, 44 children, best 109
+ *    15  chaos 9 - 11ms, 34 of 34 children, best 127     chaos 23 - 25ms, 34 of 34 children, best 135
+ *        order 18 - 23ms, 85 children, best 56           order 20 - 23ms, 56 children, best 91
+ *    25  chaos 17 - 18ms, 24 of 24 children, best 180    chaos 25 - 26ms, 24 of 24 children, best 217
+ *        order 19ms, 74 children, best 105               order 21 - 22ms, 56 children, best 142
+ *    35  chaos 20 - 21ms, 14 of 14 children, best 407    chaos 20 - 21ms, 14 of 14 children, best 429
+ *        order 13ms, 47 children, best 103               order 14 - 17ms, 47 children, best 106
+ * (best: visits of the chosen move)
+ *
+ * Widened nodes below the root have few children, so more iterations end in new order nodes and chaos edge blocks,
+ * which are larger than the chaos nodes that order nodes expand otherwise.
+ *
+ * 1500ms per game against the same search without progressive widening, 120 games per row, average final score
+ * (order maximises), 73.9 without progressive widening on either side:
+ * one prior temperature of 3 points: 73.7 as order, 71.7 as chaos
+ * one prior temperature of 1.5 points: 72.2 as order, 70.5 as chaos
+ * order 6 points, chaos 1.5 points: 73.2 as order, 71.1 as chaos
+ * temperature 3 points, twice WIDENING_FACTOR: 73.2 as order, 74.1 as chaos
+ * temperature 3 points, no prior term in the selection: 74.2 as order, 72.6 as chaos
+ */
+// Children of the root and visits of the chosen move after the same number of iterations, every child is expanded by a
+// rollout of its own. Both searches start from the benchmark position, chaos places a chip of colour 1.
+template <uint ROLLOUTS = 3'000>
+inline void benchmark_progressive_widening() {
+    using namespace mcts;
+    for (uint chips : {5, 15, 25, 35}) {
+        const auto [b, pool] = create_benchmark_position(chips);
+        for (bool widening : {false, true}) {
+            mcts::RNG.seed = 0;
+            SearchEnvironment env{.45, ROLLOUTS};
+            env.progressive_widening = widening;
+
+            auto begin = Clock::now();
+            auto &chaos_root = env.chaos_node(env.chaos_arena->create(b, pool));
+            env.tree_search_chaos(chaos_root, 1);
+            const double chaos_millis = millis_between(begin, Clock::now());
+            const uint chaos_children = chaos_root.get_edges(1, env)->published, cells = chaos_root.get_edges(1, env)->cells;
+            const uint chaos_best = env.order_node(chaos_root.select_best_edge(1, env).node).get_total_visits();
+            const std::size_t chaos_nodes = env.order_arena->live_nodes() + env.chaos_arena->live_nodes();
+            env.reset();
+
+            begin = Clock::now();
+            auto &order_root = env.order_node(env.order_arena->create(b, pool));
+            env.tree_search_order(order_root);
+            const double order_millis = millis_between(begin, Clock::now());
+            const uint order_best = env.chaos_node(order_root.select_best_edge(env).node).get_total_visits();
+            const std::size_t order_nodes = env.order_arena->live_nodes() + env.chaos_arena->live_nodes();
+
+            std::cerr << chips << " chips, " << (widening ? "progressive widening" : "every child first") << ": chaos "
+                      << chaos_millis << "ms, " << chaos_children << " of " << cells << " children, best move "
+                      << chaos_best << " visits, " << chaos_nodes << " nodes; order " << order_millis << "ms, "
+                      << order_root.get_children() << " children, best move " << order_best << " visits, " << order_nodes
+                      << " nodes\n";
+            env.reset();
+        }
+    }
+}
+
+/*
+ * 1000 rollouts per move, average final score of 200 games per row (standard error 0.6), release build
+ *
+ * neither side: 70.4
+ * RAVE_EQUIVALENCE 50: 70.7 on the order side, 70.5 on the chaos side
+ * RAVE_EQUIVALENCE 200, placements by cell only: 70.3 on the order side, 69.5 on the chaos side
+ * RAVE_EQUIVALENCE 200, placements by cell and colour: 69.6 on the order side, 70.4 on the chaos side
+ * RAVE_EQUIVALENCE 1000: 70.0 on the order side, 70.1 on the chaos side
+ * full playouts: 64.7 on neither side, 63.2 on the order side, 65.7 on the chaos side
+ * 2000 rollouts without RAVE against 1000: 71.4 on the order side, 69.4 on the chaos side
+ *
+ * The same placement of the same colour rarely comes back later in a simulation and a cut off playout adds two moves,
+ * so the all-moves-as-first averages are hardly more than the averages of the edges. RAVE is off by default.
+ *
+ * benchmark_rave, 100 games: 68.9 and 409ms per game on neither side, 69.2 and 370ms on the order side,
+ * 70.6 and 407ms on the chaos side
+ */
+// Self-play at a fixed number of rollouts per move, a side that blends in the all-moves-as-first statistics against
+// one that does not, average final score (order maximises)
+template <uint GAMES = 100, uint ROLLOUTS = 1'000>
+inline void benchmark_rave() {
+    const auto player = [](bool rave) {
+        mcts::SearchSettings settings{.45, ROLLOUTS};
+        settings.rave = rave;
+        return mcts::MoveMaker(mcts::SearchEnvironment{settings});
+    };
+
+    for (const char *side : {"neither", "order", "chaos"}) {
+        const bool order = !std::strcmp(side, "order"), chaos = !std::strcmp(side, "chaos");
+        double sum = 0;
+        const auto begin = Clock::now();
+        for (uint i = 0; i < GAMES; ++i) sum += simulate_game(player(chaos), player(order));
+        const double millis = millis_between(begin, Clock::now());
+
+        std::cerr << "RAVE on " << side << " side: average score " << sum / GAMES << ", " << millis / GAMES << "ms per game\n";
+    }
+}
+
+/*
+ * 4000 playouts per policy against a search of 50000 iterations, move values of a search of 10000, release build
+ *
+ * chips  greedy, cut after 2  MAST, cut after 2   greedy, cut after 8  MAST, cut after 8   greedy, full      MAST, full
+ *     5  0.9us 1.6 (0.1)      1.9us 1.9 (-0.8)    6.3us 5.5 (2.3)      11us 4.2 (0.1)      50us 15.7 (1.9)   72us 15.8 (-1.5)
+ *    15  1.3us 3.0 (-1.9)     2.5us 2.4 (-1.4)    8.3us 4.5 (-0.6)     13us 4.6 (-2.0)     39us 13.3 (-0.1)  64us 13.6 (-3.5)
+ *    25  1.1us 5.0 (-4.5)     1.9us 4.6 (-4.3)    8.5us 5.7 (-3.8)     14us 5.9 (-3.9)     24us 10.8 (-1.2)  30us 11.3 (-1.7)
+ *    35  0.8us 2.7 (-1.0)     1.4us 3.3 (-2.8)    5.4us 6.7 (3.3)      7.8us 5.6 (-0.1)    8.8us 10.7 (5.2)  13us 9.0 (1.1)
+ * (time per playout, rmse of a single playout, bias in parentheses)
+ *
+ * 1000 rollouts per move against the same search without MAST, average final score of 200 games per row (standard
+ * error 0.6), 70.6 on neither side with playouts cut after 2 chips and 65.5 with full playouts:
+ * cut after 2 chips: 70.6 on the order side, 70.6 on the chaos side
+ * full playouts without noise: 63.3 on the order side, 67.3 on the chaos side
+ * full playouts without noise and MAST_EXPLORATION 0: 62.6 on the order side, 68.3 on the chaos side
+ * full playouts, MAST_NOISE 6: 64.8 on the order side, 66.0 on the chaos side
+ *
+ * A move keeps its value across positions where it means something else, so the values hardly say more than the
+ * immediate score, and without the noise the playouts repeat the same tie-breaks. A cut off playout plays two moves,
+ * which the tree mostly chose already. MAST is off by default.
+ */
+// Playouts of the greedy and of the MAST policy against the value of a deep search from the same position, order to
+// move. The move values are the ones a search of TRAINING_ROLLOUTS iterations leaves, the error of a single playout is
+// its distance to the value of the move the deep search chose.
+template <uint REFERENCE_ROLLOUTS = 50'000, uint TRAINING_ROLLOUTS = 10'000, uint ROLLOUTS = 4'000>
+inline void benchmark_mast() {
+    using namespace mcts;
+    for (uint chips : {5, 15, 25, 35}) {
+        const auto [b, pool] = create_benchmark_position(chips);
+        RNG.seed = 0;
+
+        SearchEnvironment reference_search{.45, REFERENCE_ROLLOUTS};
+        auto &reference_root = reference_search.order_node(reference_search.order_arena->create(b, pool));
+        reference_search.tree_search_order(reference_root);
+        const double reference = reference_search.chaos_node(reference_root.select_best_edge(reference_search).node).average_score();
+
+        SearchEnvironment training{.45, TRAINING_ROLLOUTS};
+        training.mast = true;
+        training.tree_search_order(training.order_node(training.order_arena->create(b, pool)));
+
+        std::cerr << chips << " chips, value of the deep search " << reference << '\n';
+        for (uint cut_after : {2u, 8u, BOARD_AREA}) {
+            for (const MoveValueTable *policy : {static_cast<const MoveValueTable *>(nullptr), training.rollout_policy()}) {
+                double sum = 0, squared_error = 0;
+                const auto begin = Clock::now();
+                for (uint i = 0; i < ROLLOUTS; ++i) {
+                    const double score = smart_rollout_order(b, pool, cut_after, nullptr, policy);
+                    sum += score;
+                    squared_error += (score - reference) * (score - reference);
+                }
+                const double millis = millis_between(begin, Clock::now());
+
+                std::cerr << "  " << (policy ? "MAST" : "greedy") << ", cut after " << cut_after << " chips: "
+                          << millis * 1000 / ROLLOUTS << "us per playout, bias " << sum / ROLLOUTS - reference << ", rmse "
+                          << std::sqrt(squared_error / ROLLOUTS) << '\n';
+            }
+        }
+    }
+}
+
+/*
+ * 40 runs of 2000 iterations, standard deviation of the estimate between the runs, release build
+ *
+ * chips  drawn: chance root  order root      scheduled: chance root  order root
+ *     5         105.27 0.031  108.56 0.185              105.29 0.028  108.66 0.137
+ *    15          95.89 0.060   99.83 0.228               95.99 0.051   99.79 0.196
+ *    25          87.01 0.050   92.28 0.161               86.80 0.044   92.23 0.164
+ *    35          72.19 0.058   74.99 0.229               72.11 0.039   75.03 0.184
+ * (mean of the estimates, then their standard deviation)
+ *
+ * Scheduling takes as long as drawing, 25 - 33ms per run either way. The visits of a chance node no longer depend on
+ * the draws, only the rollouts are left to vary, so its estimate spreads up to 30% less. The difference is smaller
+ * for the order root, where the choice of the move varies between the runs as well.
+ *
+ * 1000 rollouts per move against the same search with drawn colours, average final score of 300 games per row
+ * (standard error 0.5): 69.5 on neither side, 69.8 on the order side, 69.6 on the chaos side
+ */
+// Spread of the value estimates of independent searches of the same position, with the colours below the root drawn
+// from the pool and with the colours scheduled. The chance root is the position before the chip is drawn, searched by
+// ponder, which also schedules the colour of the root. The order root reports the value of the chance node after its
+// chosen move.
+template <uint RUNS = 40, uint ROLLOUTS = 2'000>
+inline void benchmark_stratified_colours() {
+    using namespace mcts;
+    for (uint chips : {5, 15, 25, 35}) {
+        const auto [b, pool] = create_benchmark_position(chips);
+        for (bool stratified : {false, true}) {
+            RNG.seed = 0;
+            double chance_sum = 0, chance_squares = 0, order_sum = 0, order_squares = 0;
+            const auto begin = Clock::now();
+            for (uint run = 0; run < RUNS; ++run) {
+                SearchEnvironment env{.45, ROLLOUTS};
+                env.stratified_colours = stratified;
+
+                const std::atomic<bool> stop{false};
+                auto &chance_root = env.chaos_node(env.chaos_arena->create(b, pool));
+                env.ponder(chance_root, stop);
+                const double chance_value = chance_root.average_score();
+                chance_sum += chance_value;
+                chance_squares += chance_value * chance_value;
+                env.reset();
+
+                auto &order_root = env.order_node(env.order_arena->create(b, pool));
+                env.tree_search_order(order_root);
+                const double order_value = env.chaos_node(order_root.select_best_edge(env).node).average_score();
+                order_sum += order_value;
+                order_squares += order_value * order_value;
+            }
+            const double millis = millis_between(begin, Clock::now());
+
+            const double chance_mean = chance_sum / RUNS, order_mean = order_sum / RUNS;
+            std::cerr << chips << " chips, " << (stratified ? "scheduled" : "drawn") << " colours: chance root "
+                      << chance_mean << " +- " << std::sqrt(chance_squares / RUNS - chance_mean * chance_mean)
+                      << ", order root " << order_mean << " +- " << std::sqrt(order_squares / RUNS - order_mean * order_mean)
+                      << ", " << millis / RUNS << "ms per run\n";
         }
     }
 }
@@ -136,6 +506,268 @@ inline void benchmark_rollout() {
     });
 }
 
+/*
+ * 2000 playouts per cut off against the average of 4000 full playouts, order to move, release build
+ *
+ * chips  cut after 0       cut after 2       cut after 4       cut after 8       cut after 16      full playout
+ *     5  0.13us 4.5 (-4.5) 1.1us 2.6 (-2.1)  2.7us 3.2 (-1.3)  7.0us 4.8 (0.1)   19us 7.8 (-0.7)   55us 15.8
+ *    15  0.15us 2.2 (-2.2) 2.0us 2.8 (-1.7)  4.8us 3.3 (-1.5)  12us 4.4 (-0.2)   23us 7.9 (-0.5)   41us 13.4
+ *    25  0.10us 2.6 (-2.6) 1.2us 3.9 (-3.3)  3.0us 4.1 (-3.0)  8.1us 4.8 (-2.6)  19us 7.7 (-1.2)   29us 10.9
+ *    35  0.13us 5.6 (-5.6) 1.3us 6.8 (-6.3)  3.0us 6.1 (-4.6)  7.8us 6.2 (-1.9)  13us 9.0 (-0.3)   13us 9.2
+ * (time per playout, rmse of a single playout, bias in parentheses)
+ *
+ * 1500ms per game against the same search with full playouts, 24 games per row, average final score (order maximises):
+ * full playouts: 58.3 as order, 62.5 as chaos
+ * cut after 0 chips: 81.4 as order, 69.7 as chaos
+ * cut after 2 chips: 85.0 as order, 54.2 as chaos
+ * cut after 4 chips: 78.9 as order, 57.0 as chaos
+ * cut after 8 chips: 68.8 as order, 54.2 as chaos
+ * cut after 16 chips: 62.3 as order, 56.2 as chaos
+ */
+// Playouts cut off after a number of chips against the average of full playouts from the same position, the error of a
+// single playout is its distance to that average, so it holds the noise of the playout as well as the bias of the estimate
+template <uint REFERENCE_ROLLOUTS = 4'000, uint ROLLOUTS = 2'000>
+inline void benchmark_value_function() {
+    for (uint chips : {5, 15, 25, 35}) {
+        const auto [b, pool] = create_benchmark_position(chips);
+        mcts::RNG.seed = 0;
+
+        double reference = 0;
+        for (uint i = 0; i < REFERENCE_ROLLOUTS; ++i) reference += mcts::smart_rollout_order(b, pool);
+        reference /= REFERENCE_ROLLOUTS;
+
+        std::cerr << chips << " chips, average of full playouts " << reference << ", value function "
+                  << estimate_final_score(b, pool) << '\n';
+        for (uint cut_after : {0u, 2u, 4u, 8u, 16u, BOARD_AREA}) {
+            double sum = 0, squared_error = 0;
+            const auto begin = Clock::now();
+            for (uint i = 0; i < ROLLOUTS; ++i) {
+                const double score = mcts::smart_rollout_order(b, pool, cut_after);
+                sum += score;
+                squared_error += (score - reference) * (score - reference);
+            }
+            const double millis = millis_between(begin, Clock::now());
+
+            std::cerr << "  cut after " << cut_after << " chips: " << millis * 1000 / ROLLOUTS << "us per playout, bias "
+                      << sum / ROLLOUTS - reference << ", rmse " << std::sqrt(squared_error / ROLLOUTS) << '\n';
+        }
+    }
+}
+
+/*
+ * 200000 rollouts, release build
+ *
+ * scalar: 12900ms - 13400ms, ~15k rollouts/s (10200ms - 10900ms, ~19k rollouts/s with LINE_SLIDE_TABLE,
+ *         9180ms - 9960ms, ~21k rollouts/s with RolloutBoard)
+ * AVX2: 6400ms - 6650ms, ~30.5k rollouts/s
+ * AVX-512: 3950ms - 4200ms, ~49k rollouts/s
+ */
+// Every kernel up to the widest one the CPU supports plays the same playouts from the benchmark position
+template <uint ROLLOUTS = 200'000>
+inline void benchmark_rollout_batch() {
+    using namespace mcts;
+    const auto [b, pool] = create_benchmark_position();
+
+    for (auto kernel : {RolloutKernel::SCALAR, RolloutKernel::AVX2, RolloutKernel::AVX512}) {
+        if (kernel > rollout_batch_kernel()) break;
+        mcts::RNG.seed = 0;
+
+        const auto begin = Clock::now();
+        const uint score = rollout_batch(b, pool, ROLLOUTS, true, kernel);
+        const double millis = millis_between(begin, Clock::now());
+
+        std::cerr << "Batched rollouts (" << rollout_kernel_name(kernel) << "): " << millis << "ms, "
+                  << ROLLOUTS / millis * 1000 << " rollouts/s, average score " << double(score) / ROLLOUTS << '\n';
+    }
+}
+
+// The position after every chaos move of a game with random chaos moves and no order moves
+inline std::vector<MinimalBoardState> create_game_positions() {
+    std::vector<MinimalBoardState> positions;
+    FastRand rand{0};
+    BoardState b;
+    ChipPool pool;
+    RandomMoveMaker rando{1};
+    for (uint i = 0; i < BOARD_AREA; ++i) {
+        Colour c = pool.random_chip(rand);
+        pool = ChipPool(pool, c);
+        auto m = rando.suggest_chaos_move(c);
+        b.place_chip(m);
+        rando.register_chaos_move(m);
+        positions.push_back(b.get_minimal_state());
+    }
+    return positions;
+}
+
+// Runs `f` on both board layouts of every position, the callbacks sum their arguments so that nothing is optimized out
+template <std::size_t N, typename Function>
+inline void benchmark_board_layouts(const char *name, const std::vector<MinimalBoardState> &positions, Function &&f) {
+    std::vector<BitBoardState> bit_boards(positions.begin(), positions.end());
+    uint check[2]{};
+
+    const auto begin = Clock::now();
+    for (std::size_t i = 0; i < N; ++i) {
+        for (const auto &board : positions) check[0] += f(board);
+    }
+    const auto middle = Clock::now();
+    for (std::size_t i = 0; i < N; ++i) {
+        for (const auto &board : bit_boards) check[1] += f(board);
+    }
+    const auto end = Clock::now();
+
+    std::cerr << name << ": strings " << millis_between(begin, middle) << "ms, bitboards " << millis_between(middle, end)
+              << "ms" << (check[0] == check[1] ? "\n" : ", results differ!\n");
+}
+
+/*
+ * N=100000, the 49 positions of one game, release build
+ *
+ *                                          strings       bitboards
+ * for_each_empty_space                     155-190ms     70-110ms
+ * for_each_possible_order_move             560-890ms     570-820ms
+ * for_each_possible_order_move_with_score  1730-1780ms   2950-3650ms   (2500-3300ms before LINE_SLIDE_TABLE)
+ * for_each_possible_chaos_move_with_score  300-435ms     460-620ms
+ */
+template <std::size_t N = 100'000>
+inline void benchmark_bit_board() {
+    const auto positions = create_game_positions();
+
+    benchmark_board_layouts<N>("for_each_empty_space", positions, [](const auto &board) {
+        uint sum = 0;
+        board.for_each_empty_space([&sum](Position p) { sum += p.p; });
+        return sum;
+    });
+    benchmark_board_layouts<N>("for_each_possible_order_move", positions, [](const auto &board) {
+        uint sum = 0;
+        board.for_each_possible_order_move([&sum](Position from, Position to) { sum += from.p * to.p; });
+        return sum;
+    });
+    benchmark_board_layouts<N>("for_each_possible_order_move_with_score", positions, [](const auto &board) {
+        uint sum = 0;
+        board.for_each_possible_order_move_with_score([&sum](Position from, Position to, int score) { sum += from.p * to.p * uint(score); });
+        return sum;
+    });
+    benchmark_board_layouts<N>("for_each_possible_chaos_move_with_score", positions, [](const auto &board) {
+        uint sum = 0;
+        board.for_each_possible_chaos_move_with_score(3, [&sum](Position p, uint score) { sum += p.p * score; });
+        return sum;
+    });
+}
+
+/*
+ * N=4194304 random strings, release build
+ *
+ *               independent lookups   dependent lookups
+ * complete      2.2ns - 4.8ns         34ns - 57ns
+ * compact       3.8ns - 6.7ns         11ns - 14ns
+ *
+ * benchmark rollout-batch, scalar: 14.6k - 16k rollouts/s with the complete table, 6.5k - 7.4k with
+ * ENTROPY_COMPACT_SCORE_TABLE.
+ * A rollout scores the same few strings over and over, the parts of the complete table it reads stay cached.
+ */
+// Random access to the complete and the compact score table, independent lookups measure the throughput and a chain of
+// lookups that each depend on the previous score the latency
+template <std::size_t N = 1 << 22>
+inline void benchmark_score_tables() {
+    std::vector<uint> strings(N);
+    FastRand rand{0};
+    for (auto &s : strings) s = (rand() << 15 | rand()) & (COMPLETE_SCORE_LOOKUP_TABLE[0].size() - 1);
+
+    const auto run = [&strings](const char *name, auto &&lookup) {
+        uint sum = 0, chain = 0;
+        const auto begin = Clock::now();
+        for (uint s : strings) sum += lookup(BoardString{s});
+        const auto middle = Clock::now();
+        for (uint s : strings) chain = lookup(BoardString{s ^ chain});
+        const auto end = Clock::now();
+
+        std::cerr << name << ": independent " << millis_between(begin, middle) * 1e6 / N << "ns, dependent "
+                  << millis_between(middle, end) * 1e6 / N << "ns per lookup (" << sum + chain << ")\n";
+        return sum;
+    };
+
+    const uint complete = run("Complete score table", [](BoardString s) { return uint(COMPLETE_SCORE_LOOKUP_TABLE[0][s.hash]); });
+    const uint compact = run("Compact score table", lookup_compact_score);
+    if (complete != compact) std::cerr << "scores differ!\n";
+}
+
+/*
+ * N=100000, the 49 positions of one game, every colour, release build
+ *
+ * for_each_possible_chaos_move_with_score: 2400ms - 3250ms
+ * for_each_possible_chaos_move_with_delta: 2500ms - 3400ms
+ *
+ * benchmark rollout-batch, scalar: 16k - 19k rollouts/s with scores, 14k - 15k with placement_delta_table.
+ * The 16 MiB table does not stay in the L2 like the lines of the score table that a rollout reads.
+ */
+template <std::size_t N = 100'000>
+inline void benchmark_placement_deltas() {
+    const auto positions = create_game_positions();
+    placement_delta_table();
+
+    const auto run = [&positions](const char *name, auto &&for_each) {
+        uint sum = 0;
+        const auto begin = Clock::now();
+        for (std::size_t i = 0; i < N; ++i) {
+            for (const auto &board : positions) {
+                for (Colour c = 1; c < BOARD_COLOURS; ++c) for_each(board, c, [&sum](Position p, uint score) { sum += p.p * score; });
+            }
+        }
+        std::cerr << name << ": " << millis_between(begin, Clock::now()) << "ms (" << sum << ")\n";
+        return sum;
+    };
+
+    const uint scores = run("for_each_possible_chaos_move_with_score", [](const auto &board, Colour c, auto &&f) {
+        board.for_each_possible_chaos_move_with_score(c, f);
+    });
+    const uint deltas = run("for_each_possible_chaos_move_with_delta", [](const auto &board, Colour c, auto &&f) {
+        board.for_each_possible_chaos_move_with_delta(c, f);
+    });
+    if (scores != deltas) std::cerr << "scores differ!\n";
+}
+
+// What a fresh process does before it can answer its first move, run by benchmark_startup
+inline void benchmark_first_move() {
+    mcts::MoveMaker move_maker({.45, 1'000});
+    move_maker.suggest_chaos_move(1);
+}
+
+/*
+ * N=20, release build
+ *
+ * score table built at startup in every translation unit: ~295ms per process
+ * built at startup once (ENTROPY_GENERATE_SCORE_TABLE=OFF, merged source): 180ms - 183ms per process
+ * generated at build time: 101ms - 115ms per process
+ * first move from the opening book: 6.5ms per process
+ * and the compact score table only built when it is used: 4.4ms - 5.2ms per process, 5.2ms - 6.0ms before on the
+ * same machine
+ */
+// Launches `executable` for its first move again and again, the score lookup table is part of the startup cost
+template <uint N = 20>
+inline void benchmark_startup(const char *executable) {
+#ifdef _WIN32
+    const std::string command = std::string(executable) + " benchmark first-move 2>NUL";
+#else
+    const std::string command = std::string(executable) + " benchmark first-move 2>/dev/null";
+#endif
+
+    const auto begin = Clock::now();
+    for (uint i = 0; i < N; ++i) {
+        if (std::system(command.c_str())) {
+            std::cerr << "could not run " << command << '\n';
+            return;
+        }
+    }
+    const double millis = millis_between(begin, Clock::now());
+
+#ifdef ENTROPY_GENERATED_SCORE_TABLE
+    const char *table = "generated at build time";
+#else
+    const char *table = "built at startup";
+#endif
+    std::cerr << "Startup to first move (score table " << table << "): " << millis / N << "ms per process\n";
+}
+
 template <uint GAMES = 5>
 inline void benchmark_simulated_game() {
     using namespace mcts;
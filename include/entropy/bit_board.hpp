@@ -0,0 +1,242 @@
+#pragma once
+
+#include "board.hpp"
+
+#include <array>
+#include <cstdint>
+
+namespace entropy {
+
+// One bit per cell, bit `row * BOARD_SIZE + column`, or `column * BOARD_SIZE + row` for a transposed board
+using BitBoard = std::uint64_t;
+
+constexpr inline BitBoard BIT_BOARD_MASK = (BitBoard(1) << BOARD_AREA) - 1;
+constexpr inline uint LINE_MASK = (1u << BOARD_SIZE) - 1;
+constexpr inline uint COLOUR_PLANES = 3;
+
+static_assert(BOARD_AREA <= 64 && BOARD_COLOURS == 1 << COLOUR_PLANES);
+
+// Moves the 7 bits of a line to every third bit, which lays out one colour plane of a BoardString
+constexpr inline auto generate_spread_line_table() {
+    std::array<uint, 1 << BOARD_SIZE> result{};
+    for (uint bits = 0; bits < result.size(); ++bits) {
+        for (uint i = 0; i < BOARD_SIZE; ++i) result[bits] |= (bits >> i & 1) << (i * COLOUR_PLANES);
+    }
+    return result;
+}
+
+constexpr inline auto SPREAD_LINE_TABLE = generate_spread_line_table();
+
+constexpr inline auto generate_first_column_mask() {
+    BitBoard result = 0;
+    for (uint row = 0; row < BOARD_SIZE; ++row) result |= BitBoard(1) << (row * BOARD_SIZE);
+    return result;
+}
+
+constexpr inline BitBoard FIRST_COLUMN_MASK = generate_first_column_mask();
+constexpr inline BitBoard LAST_COLUMN_MASK = FIRST_COLUMN_MASK << (BOARD_SIZE - 1);
+
+// Empty cells a chip can slide to towards higher columns, found by flooding the occupied cells through the empty ones
+constexpr inline BitBoard forward_slide_targets(BitBoard occupied) {
+    const BitBoard empty = ~occupied & BIT_BOARD_MASK & ~FIRST_COLUMN_MASK;
+    BitBoard fill = occupied;
+    for (uint i = 1; i < BOARD_SIZE; ++i) fill |= fill << 1 & empty;
+    return fill & ~occupied;
+}
+
+constexpr inline BitBoard backward_slide_targets(BitBoard occupied) {
+    const BitBoard empty = ~occupied & BIT_BOARD_MASK & ~LAST_COLUMN_MASK;
+    BitBoard fill = occupied;
+    for (uint i = 1; i < BOARD_SIZE; ++i) fill |= fill >> 1 & empty;
+    return fill & ~occupied;
+}
+
+// Cell of a bit in a board laid out row by row, or column by column
+constexpr inline auto generate_bit_position_table() {
+    std::array<std::array<uint8_t, BOARD_AREA>, 2> result{};
+    for (uint p = 0; p < BOARD_AREA; ++p) {
+        result[0][p] = uint8_t(p);
+        result[1][p] = uint8_t(p % BOARD_SIZE * BOARD_SIZE + p / BOARD_SIZE);
+    }
+    return result;
+}
+
+constexpr inline auto BIT_POSITION_TABLE = generate_bit_position_table();
+
+// Drop-in alternative to MinimalBoardState that keeps an occupancy bitboard and three colour bit-planes.
+// Every board is stored twice, row by row and column by column, so that both the rows and the columns are
+// contiguous bits: empty cells and slide targets come from masks and bit scans instead of reading cell by cell.
+// The strings for the score lookups are rebuilt from the planes, see BitBoardState::get_horizontal_string.
+// Moves are enumerated in a different order than by MinimalBoardState.
+class BitBoardState {
+public:
+    BitBoardState() = default;
+
+    explicit BitBoardState(const MinimalBoardState &board) {
+        for (uint row = 0; row < BOARD_SIZE; ++row) {
+            for (uint column = 0; column < BOARD_SIZE; ++column) {
+                if (auto c = board.read_chip(row, column)) place_chip(row, column, Colour(c));
+            }
+        }
+    }
+
+    uint read_chip(uint row, uint column) const {
+        const uint p = row * BOARD_SIZE + column;
+        uint c = 0;
+        for (uint k = 0; k < COLOUR_PLANES; ++k) c |= uint(planes[0][k] >> p & 1) << k;
+        return c;
+    }
+
+    void place_chip(uint row, uint column, Colour c) {
+        const uint p[2]{row * BOARD_SIZE + column, column * BOARD_SIZE + row};
+        for (uint t = 0; t < 2; ++t) {
+            occupied[t] |= BitBoard(1) << p[t];
+            for (uint k = 0; k < COLOUR_PLANES; ++k) planes[t][k] |= BitBoard(c >> k & 1) << p[t];
+        }
+    }
+
+    void remove_chip(uint row, uint column) {
+        const uint p[2]{row * BOARD_SIZE + column, column * BOARD_SIZE + row};
+        for (uint t = 0; t < 2; ++t) {
+            occupied[t] &= ~(BitBoard(1) << p[t]);
+            for (auto &plane : planes[t]) plane &= ~(BitBoard(1) << p[t]);
+        }
+    }
+
+    void move_chip(Position from, Position to) {
+        const auto c = Colour(read_chip(from.row(), from.column()));
+        remove_chip(from.row(), from.column());
+        place_chip(to.row(), to.column(), c);
+    }
+
+    BitBoard get_occupied() const { return occupied[0]; }
+
+    BoardString get_horizontal_string(uint row) const { return line_string(0, row); }
+
+    BoardString get_vertical_string(uint column) const { return line_string(1, column); }
+
+    uint get_score(uint row, uint column) const {
+        return lookup_score(get_horizontal_string(row)) + lookup_score(get_vertical_string(column));
+    }
+
+    uint get_total_score() const {
+        uint r = 0;
+        for (uint i = 0; i < BOARD_SIZE; ++i) r += get_score(i, i);
+        return r;
+    }
+
+    template <typename Function>
+    void for_each_empty_space(Function &&f) const {
+        for (BitBoard empty = ~occupied[0] & BIT_BOARD_MASK; empty; empty &= empty - 1) {
+            std::forward<Function>(f)(Position(__builtin_ctzll(empty)));
+        }
+    }
+
+    template <typename Function>
+    void for_each_possible_order_move(Function &&f) const {
+        for (uint t = 0; t < 2; ++t) {
+            const auto &positions = BIT_POSITION_TABLE[t];
+            for_each_slide(occupied[t], [&positions, &f](uint from, uint to) {
+                std::forward<Function>(f)(Position(positions[from]), Position(positions[to]));
+            });
+        }
+    }
+
+    template <typename Function>
+    void for_each_possible_order_move_with_score(Function &&f) const {
+        std::array<BoardString, BOARD_SIZE> strings[2];
+        std::array<int, BOARD_SIZE> scores[2];
+        for (uint t = 0; t < 2; ++t) {
+            for (uint line = 0; line < BOARD_SIZE; ++line) {
+                strings[t][line] = line_string(t, line);
+                scores[t][line] = lookup_score(strings[t][line]);
+            }
+        }
+
+        for (uint t = 0; t < 2; ++t) {
+            const BitBoard board = occupied[t];
+            const BitBoard empty = ~board & BIT_BOARD_MASK;
+            const auto &positions = BIT_POSITION_TABLE[t];
+            const auto &lines = strings[t];
+            const auto &crossing = strings[!t];
+            const auto &crossing_scores = scores[!t];
+
+            // Score change of taking each chip that has an empty neighbour off the board, and its line without it
+            int remove_score[BOARD_AREA];
+            BoardString moving_str[BOARD_AREA];
+            uint colour[BOARD_AREA];
+
+            const BitBoard movable = board & ((empty >> 1 & ~LAST_COLUMN_MASK) | (empty << 1 & ~FIRST_COLUMN_MASK));
+            for (BitBoard chips = movable; chips; chips &= chips - 1) {
+                const uint p = __builtin_ctzll(chips);
+                const uint line = p / BOARD_SIZE, i = p % BOARD_SIZE;
+                remove_score[p] = lookup_score(crossing[i].set_null_copy(line)) - crossing_scores[i] - scores[t][line];
+                moving_str[p] = lines[line].set_null_copy(i);
+                colour[p] = lines[line].read(i);
+            }
+
+            for_each_slide(board, [&](uint from, uint to) {
+                const uint line = to / BOARD_SIZE, j = to % BOARD_SIZE;
+                std::forward<Function>(f)(Position(positions[from]), Position(positions[to]),
+                                          remove_score[from] +
+                                                  lookup_score(moving_str[from].set_at_empty_copy(j, colour[from])) +
+                                                  lookup_score(crossing[j].set_at_empty_copy(line, colour[from])) -
+                                                  crossing_scores[j]);
+            });
+        }
+    }
+
+    template <typename Function>
+    void for_each_possible_chaos_move_with_score(Colour c, Function &&f) const {
+        std::array<BoardString, BOARD_SIZE> vertical;
+        std::array<uint, BOARD_SIZE> v_scores;
+        for (uint column = 0; column < BOARD_SIZE; ++column) {
+            vertical[column] = line_string(1, column);
+            v_scores[column] = lookup_score(vertical[column]);
+        }
+
+        for (uint row = 0; row < BOARD_SIZE; ++row) {
+            const uint empty = ~uint(occupied[0] >> row * BOARD_SIZE) & LINE_MASK;
+            if (!empty) continue;
+
+            const BoardString h_str = line_string(0, row);
+            const uint h_old_score = lookup_score(h_str);
+            // A fixed loop over the line beats scanning its bits, the number of empty cells is hard to predict
+            for (uint column = 0; column < BOARD_SIZE; ++column) {
+                if (!(empty >> column & 1)) continue;
+                std::forward<Function>(f)(Position(row, column), lookup_score(h_str.set_at_empty_copy(column, c)) +
+                                                                         lookup_score(vertical[column].set_at_empty_copy(row, c)) -
+                                                                         h_old_score - v_scores[column]);
+            }
+        }
+    }
+
+private:
+    // Calls `f` with the bit of the sliding chip and of its target for every slide along the lines of `board`,
+    // the chip that slides is the nearest one before the target
+    template <typename Function>
+    static void for_each_slide(BitBoard board, Function &&f) {
+        for (BitBoard targets = forward_slide_targets(board); targets; targets &= targets - 1) {
+            const uint to = __builtin_ctzll(targets);
+            std::forward<Function>(f)(63 - __builtin_clzll(board & ((BitBoard(1) << to) - 1)), to);
+        }
+        for (BitBoard targets = backward_slide_targets(board); targets; targets &= targets - 1) {
+            const uint to = __builtin_ctzll(targets);
+            std::forward<Function>(f)(__builtin_ctzll(board & ~((BitBoard(2) << to) - 1)), to);
+        }
+    }
+
+    BoardString line_string(uint transposed, uint line) const {
+        uint s = 0;
+        for (uint k = 0; k < COLOUR_PLANES; ++k) {
+            s |= SPREAD_LINE_TABLE[uint(planes[transposed][k] >> line * BOARD_SIZE) & LINE_MASK] << k;
+        }
+        return {s};
+    }
+
+    // Index 0 is laid out row by row, index 1 column by column
+    BitBoard occupied[2]{};
+    BitBoard planes[2][COLOUR_PLANES]{};
+};
+
+}// namespace entropy
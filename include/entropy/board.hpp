@@ -7,6 +7,7 @@
 #include <algorithm>
 #include <array>
 #include <iostream>
+#include <vector>
 
 namespace entropy {
 
@@ -24,11 +25,190 @@ using BoardString = NumberString<BOARD_COLOURS>;
 using BoardHash = ZobristHash<BOARD_COLOURS, BOARD_AREA>;
 
 constexpr inline auto PARTIAL_SCORE_LOOKUP_TABLE = generate_base_score_lookup_table<BOARD_COLOURS, BOARD_SIZE>();
-const auto COMPLETE_SCORE_LOOKUP_TABLE = generate_complete_score_lookup_table<BOARD_COLOURS, BOARD_SIZE, 0>(PARTIAL_SCORE_LOOKUP_TABLE);
+using ScoreLookupTable = std::array<std::array<uint8_t, LookupPow<uint>::calculate<BOARD_COLOURS, BOARD_SIZE>>, 1>;
+
+#ifdef ENTROPY_GENERATED_SCORE_TABLE
+// Written at build time by source/tools/generate_score_table.cpp, see ENTROPY_GENERATE_SCORE_TABLE in CMakeLists.txt
+extern const ScoreLookupTable COMPLETE_SCORE_LOOKUP_TABLE;
+#else
+// Built on every start, the constexpr evaluation limits of the compilers are far too low for it
+inline const ScoreLookupTable COMPLETE_SCORE_LOOKUP_TABLE = generate_complete_score_lookup_table<BOARD_COLOURS, BOARD_SIZE, 0>(PARTIAL_SCORE_LOOKUP_TABLE);
+#endif
+
+// The score of a string only depends on which of its cells are empty and which hold equal colours.
+// CompactScoreTable relabels the colours of the first PREFIX_CELLS cells in order of appearance, which leaves
+// 52 distinct prefixes, and stores the scores of those followed by every suffix: 42 KiB instead of 2 MiB.
+struct CompactScoreTable {
+    constexpr static inline uint PREFIX_CELLS = 4;
+    constexpr static inline uint SUFFIX_CELLS = BOARD_SIZE - PREFIX_CELLS;
+    constexpr static inline uint PREFIX_BITS = PREFIX_CELLS * 3;
+    constexpr static inline uint SUFFIX_BITS = SUFFIX_CELLS * 3;
+    constexpr static inline uint PATTERN_SHIFT = BOARD_COLOURS * 3;
+    constexpr static inline uint PATTERNS = 52;
+
+    // Per prefix, the new label of colour `c` at bit `3 * c` and the index of the relabelled prefix from PATTERN_SHIFT
+    std::array<uint32_t, 1 << PREFIX_BITS> prefix{};
+    std::array<uint8_t, PATTERNS << SUFFIX_BITS> scores{};
+
+    uint lookup(BoardString s) const {
+        const uint entry = prefix[s.hash & ((1 << PREFIX_BITS) - 1)];
+        uint suffix = 0;
+        for (uint i = 0; i < SUFFIX_CELLS; ++i) suffix |= (entry >> 3 * s.read(PREFIX_CELLS + i) & 7) << 3 * i;
+        return scores[(entry >> PATTERN_SHIFT) << SUFFIX_BITS | suffix];
+    }
+};
+
+/* constexpr */ inline CompactScoreTable generate_compact_score_table() {
+    CompactScoreTable result{};
+    std::array<uint8_t, 1 << CompactScoreTable::PREFIX_BITS> relabelled_index{};
+
+    // Relabelling is idempotent, the relabelled prefixes are exactly the ones it leaves unchanged
+    for (uint pass = 0, patterns = 0; pass < 2; ++pass) {
+        for (uint p = 0; p < result.prefix.size(); ++p) {
+            const BoardString original{p};
+            uint label[BOARD_COLOURS]{};
+            uint next = 1, relabelled = 0;
+            for (uint i = 0; i < CompactScoreTable::PREFIX_CELLS; ++i) {
+                if (const uint c = original.read(i)) {
+                    if (!label[c]) label[c] = next++;
+                    relabelled |= label[c] << 3 * i;
+                }
+            }
+
+            if (pass == 0) {
+                if (relabelled != p) continue;
+                relabelled_index[p] = uint8_t(patterns);
+                for (uint suffix = 0; suffix < 1 << CompactScoreTable::SUFFIX_BITS; ++suffix) {
+                    const BoardString s{p | suffix << CompactScoreTable::PREFIX_BITS};
+                    result.scores[patterns << CompactScoreTable::SUFFIX_BITS | suffix] =
+                            PARTIAL_SCORE_LOOKUP_TABLE[get_palindrome_string_equivalent<BOARD_COLOURS, BOARD_SIZE>(s).hash];
+                }
+                ++patterns;
+            } else {
+                // Colours that only appear in the suffix keep distinct labels
+                for (uint c = 1; c < BOARD_COLOURS; ++c) {
+                    if (!label[c]) label[c] = next++;
+                }
+                result.prefix[p] = uint32_t(relabelled_index[relabelled]) << CompactScoreTable::PATTERN_SHIFT;
+                for (uint c = 0; c < BOARD_COLOURS; ++c) result.prefix[p] |= label[c] << 3 * c;
+            }
+        }
+    }
+    return result;
+}
+
+#ifdef ENTROPY_COMPACT_SCORE_TABLE
+inline const CompactScoreTable COMPACT_SCORE_TABLE = generate_compact_score_table();
+
+inline const CompactScoreTable &compact_score_table() { return COMPACT_SCORE_TABLE; }
+#else
+// Only benchmark_score_tables reads it then, so it is built on first use instead of on every start
+inline const CompactScoreTable &compact_score_table() {
+    static const CompactScoreTable table = generate_compact_score_table();
+    return table;
+}
+#endif
+
+inline uint lookup_compact_score(BoardString s) {
+    return compact_score_table().lookup(s);
+}
 
+// The complete table takes one load per string, the compact one two dependent loads and a few shifts. The complete
+// table wins as long as the strings the search touches stay in the cache, ENTROPY_COMPACT_SCORE_TABLE is meant for
+// CPUs with a small L2, see benchmark_score_tables.
 template <typename IntType = int>
 inline IntType lookup_score(BoardString s) {
+#ifdef ENTROPY_COMPACT_SCORE_TABLE
+    return IntType(lookup_compact_score(s));
+#else
     return COMPLETE_SCORE_LOOKUP_TABLE[0][s.hash];
+#endif
+}
+
+// Lowest bit of every cell of a BoardString
+constexpr inline uint BOARD_STRING_LOW_BITS = 0x49249;
+
+static_assert(BOARD_COLOURS == 8 && BOARD_SIZE == 7, "BOARD_STRING_LOW_BITS assumes 3 bit cells");
+
+// Lowest bit of every cell of `s` that holds colour `c`
+constexpr inline uint cells_with_colour(BoardString s, Colour c) {
+    const uint x = s.hash ^ c * BOARD_STRING_LOW_BITS;
+    return ~(x | x >> 1 | x >> 2) & BOARD_STRING_LOW_BITS;
+}
+
+// Exchanges colour `c` with colour 1, which leaves the score and the score changes of placing chips unchanged
+constexpr inline BoardString swap_with_first_colour(BoardString s, Colour c) {
+    return {s.hash ^ (c ^ 1u) * (cells_with_colour(s, c) | cells_with_colour(s, 1))};
+}
+
+// One bit per occupied cell of `s`, the bit of cell `i` moves down from bit `3 * i` in steps of 2, 4 and 8 bits
+constexpr inline uint line_occupancy(BoardString s) {
+    uint x = (s.hash | s.hash >> 1 | s.hash >> 2) & BOARD_STRING_LOW_BITS;
+    x = (x & ~0x8208u) | (x & 0x8208u) >> 2;
+    x = (x & ~0x400c0u) | (x & 0x400c0u) >> 4;
+    return (x & ~0x7000u) | (x & 0x7000u) >> 8;
+}
+
+struct LineSlide {
+    uint8_t from;
+    uint8_t to;
+};
+
+template <typename Function>
+constexpr void for_each_line_slide(uint occupied, Function &&f) {
+    for (uint from = 0; from < BOARD_SIZE; ++from) {
+        if (!(occupied >> from & 1)) continue;
+        for (uint to = from + 1; to < BOARD_SIZE && !(occupied >> to & 1); ++to) f(from, to);
+        for (uint to = from; to-- > 0 && !(occupied >> to & 1);) f(from, to);
+    }
+}
+
+constexpr inline uint count_line_slides() {
+    uint n = 0;
+    for (uint occupied = 0; occupied < 1 << BOARD_SIZE; ++occupied) for_each_line_slide(occupied, [&n](uint, uint) { ++n; });
+    return n;
+}
+
+// The slides of a chip along a line only depend on which cells of the line are occupied. The slides for a set of
+// occupied cells are slides[begin[occupied]] up to slides[begin[occupied + 1]], grouped by the sliding chip.
+struct LineSlideTable {
+    std::array<uint16_t, (1 << BOARD_SIZE) + 1> begin{};
+    std::array<LineSlide, count_line_slides()> slides{};
+};
+
+constexpr inline LineSlideTable generate_line_slide_table() {
+    LineSlideTable result{};
+    uint n = 0;
+    for (uint occupied = 0; occupied < 1 << BOARD_SIZE; ++occupied) {
+        result.begin[occupied] = uint16_t(n);
+        for_each_line_slide(occupied, [&result, &n](uint from, uint to) { result.slides[n++] = {uint8_t(from), uint8_t(to)}; });
+    }
+    result.begin.back() = uint16_t(n);
+    return result;
+}
+
+constexpr inline LineSlideTable LINE_SLIDE_TABLE = generate_line_slide_table();
+
+// Score change of placing a chip of colour 1 on every empty cell of every string, 0 for the occupied cells.
+// The other colours are looked up with swap_with_first_colour, all colours at once would take 112 MiB instead of 16 MiB.
+using PlacementDeltaTable = std::vector<std::array<uint8_t, BOARD_COLOURS>>;
+
+inline PlacementDeltaTable generate_placement_delta_table() {
+    PlacementDeltaTable result(COMPLETE_SCORE_LOOKUP_TABLE[0].size());
+    for (uint hash = 0; hash < result.size(); ++hash) {
+        const BoardString s{hash};
+        const uint score = lookup_score(s);
+        for (uint i = 0; i < BOARD_SIZE; ++i) {
+            if (!s.read(i)) result[hash][i] = uint8_t(lookup_score(s.set_at_empty_copy(i, 1)) - score);
+        }
+    }
+    return result;
+}
+
+// Built on first use, it takes about 30ms
+inline const PlacementDeltaTable &placement_delta_table() {
+    static const PlacementDeltaTable table = generate_placement_delta_table();
+    return table;
 }
 
 struct Position {
@@ -146,6 +326,39 @@ struct OrderMove {
     };
 };
 
+// Calls `f` with every slide along `lines` from LINE_SLIDE_TABLE and its score, the change of the line the chip slides
+// along and of the two lines it crosses. `lines` are the rows of a board when VERTICAL is false, and `crossing` the columns.
+template <bool VERTICAL, typename Function>
+inline void for_each_slide_with_score(const std::array<BoardString, BOARD_SIZE> &lines,
+                                      const std::array<BoardString, BOARD_SIZE> &crossing,
+                                      const std::array<int, BOARD_SIZE> &line_scores,
+                                      const std::array<int, BOARD_SIZE> &crossing_scores,
+                                      Function &&f) {
+    for (uint line = 0; line < BOARD_SIZE; ++line) {
+        const BoardString str = lines[line];
+        const uint occupied = line_occupancy(str);
+        const LineSlide *slide = LINE_SLIDE_TABLE.slides.data() + LINE_SLIDE_TABLE.begin[occupied];
+        const LineSlide *const end = LINE_SLIDE_TABLE.slides.data() + LINE_SLIDE_TABLE.begin[occupied + 1];
+
+        uint from = BOARD_SIZE, c = 0;
+        BoardString moving_str{};
+        int remove_score = 0;
+        for (; slide != end; ++slide) {
+            if (slide->from != from) {
+                from = slide->from;
+                c = str.read(from);
+                moving_str = str.set_null_copy(from);
+                remove_score = lookup_score(crossing[from].set_null_copy(line)) - crossing_scores[from] - line_scores[line];
+            }
+            const uint to = slide->to;
+            const int score = remove_score + lookup_score(moving_str.set_at_empty_copy(to, c)) +
+                              lookup_score(crossing[to].set_at_empty_copy(line, c)) - crossing_scores[to];
+            if constexpr (VERTICAL) std::forward<Function>(f)(Position(from, line), Position(to, line), score);
+            else std::forward<Function>(f)(Position(line, from), Position(line, to), score);
+        }
+    }
+}
+
 class MinimalBoardState {
 public:
     MinimalBoardState() = default;
@@ -197,8 +410,13 @@ public:
 
     template <typename Function>
     void for_each_possible_order_move_with_score(Function &&f) const {
-        for_each_possible_order_move_with_score_helper<true>(std::forward<Function>(f));
-        for_each_possible_order_move_with_score_helper<false>(std::forward<Function>(f));
+        std::array<int, BOARD_SIZE> h_scores, v_scores;
+        for (uint i = 0; i < BOARD_SIZE; ++i) {
+            h_scores[i] = lookup_score(horizontal[i]);
+            v_scores[i] = lookup_score(vertical[i]);
+        }
+        for_each_slide_with_score<false>(horizontal, vertical, h_scores, v_scores, std::forward<Function>(f));
+        for_each_slide_with_score<true>(vertical, horizontal, v_scores, h_scores, std::forward<Function>(f));
     }
 
     template <typename Function>
@@ -232,6 +450,33 @@ public:
         }
     }
 
+    // Score change of placing a chip of colour `c` on the empty cell (row, column), two reads of placement_delta_table()
+    uint get_placement_delta(uint row, uint column, Colour c) const {
+        const auto &table = placement_delta_table();
+        return table[swap_with_first_colour(horizontal[row], c).hash][column] +
+               table[swap_with_first_colour(vertical[column], c).hash][row];
+    }
+
+    // Same moves and scores as for_each_possible_chaos_move_with_score, the scores come from placement_delta_table()
+    template <typename Function>
+    void for_each_possible_chaos_move_with_delta(Colour c, Function &&f) const {
+        const auto &table = placement_delta_table();
+        const uint8_t *v_deltas[BOARD_SIZE];
+        for (uint column = 0; column < BOARD_SIZE; ++column) {
+            v_deltas[column] = table[swap_with_first_colour(vertical[column], c).hash].data();
+        }
+
+        Position p{0};
+        for (uint row = 0; row < BOARD_SIZE; ++row) {
+            auto str = horizontal[row];
+            const auto &h_deltas = table[swap_with_first_colour(str, c).hash];
+            for (uint column = 0; column < BOARD_SIZE; ++column, ++p.p) {
+                if (!str.read_first()) std::forward<Function>(f)(p, uint(h_deltas[column] + v_deltas[column][row]));
+                str.shift_right_once();
+            }
+        }
+    }
+
 private:
     template <bool LEFT_TO_RIGHT, typename Function>
     void for_each_possible_order_move_helper(Function &&f) const {
@@ -255,56 +500,6 @@ private:
         }
     }
 
-    template <bool LEFT_TO_RIGHT, typename Function>
-    void for_each_possible_order_move_with_score_helper(Function &&f) const {
-        constexpr int STEP = LEFT_TO_RIGHT ? 1 : -1;
-        constexpr uint START = LEFT_TO_RIGHT ? 0 : (BOARD_SIZE - 1);
-
-        std::array<Position, BOARD_SIZE> v_from{};
-        std::array<BoardString, BOARD_SIZE> v_moving_str;
-        std::array<int, BOARD_SIZE> h_remove_score;
-        std::array<Colour, BOARD_SIZE> v_last_colour;
-
-        Position pos = LEFT_TO_RIGHT ? 0 : (BOARD_AREA - 1);
-        for (uint row = START; row < BOARD_SIZE; row += STEP) {
-            Position horizontal_from{};
-            auto h_moving_str = horizontal[row];
-
-            int v_remove_score;
-            Colour h_last_colour;
-
-            for (uint column = START; column < BOARD_SIZE; column += STEP) {
-                if (auto c = read_chip(row, column)) {
-                    h_last_colour = v_last_colour[column] = c;
-                    v_from[column].p = horizontal_from.p = pos.p;
-
-                    h_moving_str = horizontal[row].set_null_copy(column);
-                    v_remove_score = lookup_score(vertical[column].set_null_copy(row)) - lookup_score(vertical[column]);
-
-                    v_moving_str[column] = vertical[column].set_null_copy(row);
-                    h_remove_score[column] = lookup_score(horizontal[row].set_null_copy(column)) - lookup_score(horizontal[row]);
-                } else {
-                    if (!horizontal_from.is_none()) {
-                        std::forward<Function>(f)(horizontal_from, pos,
-                                                  v_remove_score +
-                                                          lookup_score(h_moving_str.set_at_empty_copy(column, h_last_colour)) +
-                                                          lookup_score(vertical[column].set_at_empty_copy(row, h_last_colour)) -
-                                                          get_score(row, column));
-                    }
-                    if (!v_from[column].is_none()) {
-                        std::forward<Function>(f)(v_from[column], pos,
-                                                  h_remove_score[column] +
-                                                          lookup_score(v_moving_str[column].set_at_empty_copy(row, v_last_colour[column])) +
-                                                          lookup_score(horizontal[row].set_at_empty_copy(column, v_last_colour[column])) -
-                                                          get_score(row, column));
-                    }
-                }
-
-                pos.p += STEP;
-            }
-        }
-    }
-
     std::array<BoardString, BOARD_SIZE> horizontal{};
     std::array<BoardString, BOARD_SIZE> vertical{};
 };
@@ -0,0 +1,72 @@
+#pragma once
+
+#include "board.hpp"
+
+#include <limits>
+#include <vector>
+
+namespace entropy {
+
+// Open cells at or below which the move makers solve the position instead of searching it
+constexpr inline uint ENDGAME_OPEN_CELLS = 4;
+
+constexpr inline std::size_t ENDGAME_TABLE_BYTES = 8 << 20;
+
+template <typename Move>
+struct EndgameSolution {
+    Move move;
+    float score;// exact expected final score after the move
+};
+
+// Exact expectimax over the rest of the game: order maximises, chaos minimises and the colour of every chip that
+// is still to be drawn is weighted by its count in the ChipPool. The value of a position only depends on the board,
+// so solved positions are kept between moves in a transposition table keyed by BoardHash and the player to move.
+class EndgameSolver {
+public:
+    struct Statistics {
+        std::size_t nodes = 0;
+        std::size_t table_hits = 0;
+    };
+
+    EndgameSolution<OrderMove> solve_order(const BoardState &board, const ChipPool &pool);
+
+    EndgameSolution<Position> solve_chaos(const BoardState &board, const ChipPool &pool, Colour colour);
+
+    // Expected final score with order to move. Once a move reaches `beta` the rest are skipped and the result is only a
+    // lower bound, which is enough for a placement that already has a child below `beta`.
+    float order_value(const BoardState &board, const ChipPool &pool, float beta = std::numeric_limits<float>::infinity());
+
+    // Expected final score before the next chip is drawn
+    float chaos_value(const BoardState &board, const ChipPool &pool);
+
+    // Smallest expected final score over the placements of a chip of colour `colour`
+    float placement_value(const BoardState &board, const ChipPool &pool, Colour colour);
+
+    Statistics statistics{};
+
+private:
+    struct Entry {
+        std::uint64_t key;
+        float value;
+        uint8_t open_spaces;// 0 for empty entries, full boards are never stored
+        bool lower_bound;   // an order position whose search was cut off
+    };
+
+    constexpr static std::uint64_t ORDER_TO_MOVE_KEY = 0x9e3779b97f4a7c15ull;
+    constexpr static std::size_t TABLE_SIZE = ENDGAME_TABLE_BYTES / sizeof(Entry);
+
+    static_assert((TABLE_SIZE & (TABLE_SIZE - 1)) == 0);
+
+    // Allocated by the first probe, so processes that never reach the endgame do not pay for it
+    std::vector<Entry> table;
+
+    static std::uint64_t key_of(const BoardState &board, bool order_to_move) {
+        return board.get_hash().get_value() ^ (order_to_move ? ORDER_TO_MOVE_KEY : 0);
+    }
+
+    const Entry *probe(std::uint64_t key, uint open_spaces);
+
+    void store(std::uint64_t key, uint open_spaces, float value, bool lower_bound = false);
+};
+
+}// namespace entropy
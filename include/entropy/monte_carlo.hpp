@@ -1,57 +1,510 @@
 #pragma once
 
 #include "board.hpp"
+#include "endgame_solver.hpp"
 #include "move_maker.hpp"
-
-#include <map>
+#include "node_arena.hpp"
+#include "opening_book.hpp"
+#include "rollout_batch.hpp"
+#include "time_manager.hpp"
+#include "transposition_table.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstdint>
+#include <limits>
 #include <memory>
+#include <numeric>
+#include <thread>
 #include <utility>
 
 namespace entropy::mcts {
 
-extern FastRand RNG;
+extern thread_local FastRand RNG;
 
 class MoveMaker;
 
+struct SearchEnvironment;
+struct SimulationMoves;
+class MoveValueTable;
+
 class OrderNode;
 class ChaosNode;
 
-constexpr inline std::size_t PREALLOCATED_NODE_AMOUNT = 32768;
+constexpr inline std::size_t NODE_MEMORY_BYTES = 128 << 20;
+constexpr inline std::size_t TRANSPOSITION_TABLE_BYTES = 2 << 20;// split evenly between order and chaos nodes
+
+using OrderNodeArena = NodeArena<OrderNode>;
+using ChaosNodeArena = NodeArena<ChaosNode>;
+
+// Greedy playouts to the end of the game, or cut off after `cut_after` chips with the rest estimated by value_function.hpp.
+// The moves played are appended to `moves` when it is given, with a `policy` the move values break the ties of the
+// greedy moves and sometimes replace them, see MAST_EXPLORATION.
+uint smart_rollout_order(const BoardState &board, const ChipPool &pool, uint cut_after = BOARD_AREA,
+                         SimulationMoves *moves = nullptr, const MoveValueTable *policy = nullptr);
+uint smart_rollout_chaos(const BoardState &board, const ChipPool &pool, uint cut_after = BOARD_AREA,
+                         SimulationMoves *moves = nullptr, const MoveValueTable *policy = nullptr);
+
+// Rounded average of `n` playouts that are cut off, rollout_batch always plays to the end
+template <typename Rollout>
+uint cut_rollouts(const BoardState &board, const ChipPool &pool, uint n, uint cut_after, const MoveValueTable *policy, Rollout &&rollout) {
+    uint sum = 0;
+    for (uint i = 0; i < n; ++i) sum += rollout(board, pool, cut_after, nullptr, policy);
+    return (sum + n / 2) / n;
+}
 
-using OrderNodeBuffer = PreallocatedBuffer<OrderNode, PREALLOCATED_NODE_AMOUNT>;
-using ChaosNodeBuffer = PreallocatedBuffer<ChaosNode, PREALLOCATED_NODE_AMOUNT>;
+constexpr inline float UCT_SCORE_MULTIPLIER = 1. / 80;
 
-extern OrderNodeBuffer order_node_buffer;
-extern ChaosNodeBuffer chaos_node_buffer;
+// Score penalty per pending visit of another thread, pushes the other threads towards different branches
+constexpr inline float VIRTUAL_LOSS = 1 / UCT_SCORE_MULTIPLIER;
 
-uint smart_rollout_order(const BoardState &board, const ChipPool &pool);
-uint smart_rollout_chaos(const BoardState &board, const ChipPool &pool);
+// RAVE: the all-moves-as-first average of an edge weighs as much as its own average after RAVE_EQUIVALENCE visits,
+// with the weight sqrt(RAVE_EQUIVALENCE / (3 * visits + RAVE_EQUIVALENCE))
+constexpr inline float RAVE_EQUIVALENCE = 200;
 
-constexpr inline float UCT_SCORE_MULTIPLIER = 1. / 80;
+constexpr inline uint VISITS_TABLE_SIZE = 1 << 12;
 
-inline float uct_score(float s, float logN, float n, float temperature) {
-    return s * UCT_SCORE_MULTIPLIER + temperature * std::sqrt(logN / n);
+// log(n), 1 / sqrt(n) and the RAVE weight for the visit counts of UCT
+struct VisitsTable {
+    std::array<float, VISITS_TABLE_SIZE> log;
+    std::array<float, VISITS_TABLE_SIZE> inverse_sqrt;
+    std::array<float, VISITS_TABLE_SIZE> rave_beta;
+};
+
+/* constexpr */ inline VisitsTable generate_visits_table() {
+    VisitsTable result{};
+    for (uint n = 0; n < VISITS_TABLE_SIZE; ++n) {
+        result.log[n] = std::log(float(n));
+        result.inverse_sqrt[n] = 1 / std::sqrt(float(n));
+        result.rave_beta[n] = std::sqrt(RAVE_EQUIVALENCE / (3 * float(n) + RAVE_EQUIVALENCE));
+    }
+    return result;
 }
 
-struct SearchEnvironment {
-    float uct_temperature = 0.45;
-    uint rollouts = 8'500;
+inline const VisitsTable VISITS_TABLE = generate_visits_table();
 
-    std::unordered_map<BoardHash, std::weak_ptr<OrderNode>> cached_order_nodes{};
-    std::unordered_map<BoardHash, std::weak_ptr<ChaosNode>> cached_chaos_nodes{};
+// logN of UCT for a node with `n` visits
+inline float log_visits(uint n) { return n < VISITS_TABLE_SIZE ? VISITS_TABLE.log[n] : std::log(float(n)); }
 
-    std::shared_ptr<OrderNode> get_order_node(ChaosNode *parent, const ChaosMove &move);
+inline float inverse_sqrt_visits(uint n) {
+    return n < VISITS_TABLE_SIZE ? VISITS_TABLE.inverse_sqrt[n] : 1 / std::sqrt(float(n));
+}
 
-    std::shared_ptr<ChaosNode> get_chaos_node(OrderNode *parent, const OrderMove &move);
+inline float rave_beta(uint n) {
+    return n < VISITS_TABLE_SIZE ? VISITS_TABLE.rave_beta[n] : std::sqrt(RAVE_EQUIVALENCE / (3 * float(n) + RAVE_EQUIVALENCE));
+}
 
-    void tree_search_order(OrderNode &root);
+// Move leading to a child and the child's index in the arena of its node type
+template <typename Move>
+struct Edge {
+    Move move;
+    NodeIndex node;
+};
 
-    void tree_search_chaos(ChaosNode &root, Colour c);
+// Softmax temperatures of the priors over the immediate score gain of a move, in points. The placements that add the
+// least are the better guess, most order moves add nothing right away and the prior of order stays flatter.
+constexpr inline float ORDER_PRIOR_SCALE = 6;
+constexpr inline float CHAOS_PRIOR_SCALE = 1.5;
+
+// Weight of the PUCT prior term: weight * prior * sqrt(N) / (1 + visits), in units of the UCT score
+constexpr inline float PRIOR_WEIGHT = 0.5;
+
+// Priors are stored on the edges as 16 bit fractions of PRIOR_UNIT
+constexpr inline float PRIOR_UNIT = std::numeric_limits<uint16_t>::max();
+
+// Progressive widening: a node with N visits has at most WIDENING_BASE + WIDENING_FACTOR * sqrt(N) children
+constexpr inline uint WIDENING_BASE = 2;
+constexpr inline float WIDENING_FACTOR = 1;
+
+inline uint widening_limit(uint visits) { return WIDENING_BASE + uint(WIDENING_FACTOR * std::sqrt(float(visits))); }
+
+// Keys below 256 of the moves of a node in the order they are expanded: by descending prior, or shuffled without
+// progressive widening. The first `taken` of them have a child or are being expanded. Only the order is kept, the
+// prior of a move is recomputed from its gain when it is expanded.
+template <uint N>
+class ExpansionQueue {
+public:
+    void push(uint key) { keys[count++] = uint8_t(key); }
+
+    // Orders the keys by the softmax with temperature `scale` of `gains`, the gains of the pushed keys in push order.
+    // `sign` is -1 when the player to move minimises the score.
+    template <typename Generator>
+    void sort(const float *gains, float sign, float scale, bool by_prior, Generator &&gen) {
+        if (!by_prior) {
+            for (uint i = count; i > 1; --i) std::swap(keys[i - 1], keys[std::uniform_int_distribution<uint>{0, i - 1}(gen)]);
+            sum = float(count);
+            return;
+        }
+
+        gain_factor = sign / scale;
+        offset = sign * *std::max_element(gains, gains + count, [sign](float a, float b) { return sign * a < sign * b; }) / scale;
+        sum = 0;
+        for (uint i = 0; i < count; ++i) sum += std::exp(gains[i] * gain_factor - offset);
+
+        uint8_t order[N];
+        std::iota(order, order + count, 0);
+        std::sort(order, order + count, [gains, sign](uint8_t a, uint8_t b) {
+            return sign * gains[a] > sign * gains[b] || (gains[a] == gains[b] && a < b);
+        });
+        uint8_t sorted_keys[N];
+        for (uint i = 0; i < count; ++i) sorted_keys[i] = keys[order[i]];
+        std::copy_n(sorted_keys, count, keys);
+    }
+
+    // Prior of a move with immediate score gain `gain`, the same for every move without progressive widening
+    float prior(float gain) const { return std::exp(gain * gain_factor - offset) / sum; }
+
+    uint size() const { return count; }
+
+    bool empty() const { return taken == count; }
+
+    // Whether the next move may be expanded at `visits` visits of the node, with `proven` of the taken moves proven.
+    // Widening waits for the visits unless every child is proven and selection has nothing left to descend.
+    bool may_take(bool widening, uint visits, uint proven) const {
+        return !empty() && (!widening || taken < widening_limit(visits) || proven == taken);
+    }
+
+    uint take() { return keys[taken++]; }
+
+    // Returns a key whose expansion failed to the moves that are not taken
+    void put_back(uint key) {
+        --taken;
+        std::swap(*std::find(keys, keys + taken, uint8_t(key)), keys[taken]);
+    }
+
+private:
+    uint8_t keys[N];
+    uint8_t count = 0;
+    uint8_t taken = 0;
+    float gain_factor = 0, offset = 0, sum = 1;
+};
+
+constexpr inline uint8_t NO_EDGE = std::numeric_limits<uint8_t>::max();
+
+// Exact value of a node whose subtree is fully searched, proven bottom-up from the final positions: the maximum of
+// the children for Order, for Chaos the expectation over the colours of the minimum over the cells
+class ProvenValue {
+public:
+    bool is_proven() const { return proven.load(std::memory_order_acquire); }
+
+    float get() const { return value.load(std::memory_order_relaxed); }
+
+    // Proven values stand in for the rollout scores, which are whole points
+    uint score() const { return uint(get() + .5f); }
+
+    void set(float v) {
+        value.store(v, std::memory_order_relaxed);
+        proven.store(true, std::memory_order_release);
+    }
+
+private:
+    std::atomic<float> value = 0;
+    std::atomic<bool> proven = false;
+};
+
+// All-moves-as-first statistics of the edges of a node by edge position: the simulations through the node that played
+// the move of the edge later on. They live in arenas of their own, which only hand out blocks when RAVE is on, so
+// that the nodes do not carry them otherwise.
+template <std::size_t N>
+struct AmafStatistics {
+    std::atomic<uint> visits[N]{};
+    std::atomic<uint> scores[N]{};
+
+    void record(uint slot, uint score) {
+        visits[slot].fetch_add(1, std::memory_order_relaxed);
+        scores[slot].fetch_add(score, std::memory_order_relaxed);
+    }
+};
+
+using OrderAmafStatistics = AmafStatistics<MAX_POSSIBLE_ORDER_MOVES>;
+using ChaosAmafStatistics = AmafStatistics<BOARD_AREA>;
+
+using OrderAmafArena = NodeArena<OrderAmafStatistics>;
+using ChaosAmafArena = NodeArena<ChaosAmafStatistics>;
+
+// A visit count in the low half of a word and a score sum in the high half, so that one atomic operation updates both
+// and one load reads a consistent pair
+inline std::uint64_t pack_visits(uint visits, uint score) { return visits | std::uint64_t(score) << 32; }
+inline uint unpack_visits(std::uint64_t entry) { return uint(entry); }
+inline uint unpack_score(std::uint64_t entry) { return uint(entry >> 32); }
+
+// Visits and score sums of the edges of a node by edge position, in arrays of their own so that UCT selection scans
+// them without reading any child. A child that several parents share through the transposition table is counted
+// separately per edge.
+template <std::size_t N>
+struct EdgeStatistics {
+    std::atomic<std::uint64_t> entries[N];// see pack_visits
+    std::atomic<uint16_t> virtual_visits[N];// pending visits of other threads, at most one per thread
+    uint16_t priors[N];// fractions of PRIOR_UNIT, written before the edge is published
+
+    // Edges to a child with a ProvenValue, selection skips them
+    std::atomic<std::uint64_t> proven[(N + 63) / 64]{};
+    std::atomic<uint> proven_count{};
+
+    bool is_proven(uint slot) const { return proven[slot / 64].load(std::memory_order_relaxed) >> slot % 64 & 1; }
+
+    void prove(uint slot) {
+        const std::uint64_t bit = std::uint64_t(1) << slot % 64;
+        if (!(proven[slot / 64].fetch_or(bit, std::memory_order_relaxed) & bit)) ++proven_count;
+    }
+
+    // Before the edge is published, with the first rollout of its child
+    void init(uint slot, uint score, float prior) {
+        priors[slot] = uint16_t(prior * PRIOR_UNIT + .5f);
+        entries[slot].store(pack_visits(1, score), std::memory_order_relaxed);
+        virtual_visits[slot].store(0, std::memory_order_relaxed);
+    }
+
+    void record_score(uint slot, uint score) { add(slot, 1, score); }
+
+    // Visits and scores merged from another search
+    void add(uint slot, uint visits, uint score) { entries[slot].fetch_add(pack_visits(visits, score), std::memory_order_relaxed); }
+
+    // Records a visit of an edge to a chance node whose value is `value` after the visit. The sum is kept at the visits
+    // times the value instead of the sum of the scores, so that the average is the chip-weighted mean of the node. The
+    // visits and the sum are replaced together, a thread that loses the race recomputes the sum for the new count.
+    void record_value(uint slot, float value) {
+        std::uint64_t entry = entries[slot].load(std::memory_order_relaxed), next;
+        do {
+            const uint v = unpack_visits(entry) + 1;
+            next = pack_visits(v, uint(value * float(v) + .5f));
+        } while (!entries[slot].compare_exchange_weak(entry, next, std::memory_order_relaxed));
+    }
+
+    uint visits(uint slot) const { return unpack_visits(entries[slot].load(std::memory_order_relaxed)); }
+
+    uint score_sum(uint slot) const { return unpack_score(entries[slot].load(std::memory_order_relaxed)); }
+
+    float average_score(uint slot) const {
+        const std::uint64_t entry = entries[slot].load(std::memory_order_relaxed);
+        return float(unpack_score(entry)) / float(unpack_visits(entry));
+    }
+
+    // Position of the first unproven edge with the highest UCT score of the first `n`, the averages are negated when
+    // the player to move minimises the score. NO_EDGE when all of them are proven.
+    // UCT score: average * UCT_SCORE_MULTIPLIER + temperature * sqrt(logN / visits) + prior_exploration * prior / (1 + visits),
+    // with the virtual loss. `prior_exploration` is PRIOR_WEIGHT * sqrt(N), or 0 to leave the priors out. With `amaf`
+    // the average is blended with the all-moves-as-first average, see RAVE_EQUIVALENCE.
+    template <bool MINIMISE>
+    uint select(uint n, float logN, float uct_temperature, float prior_exploration, const AmafStatistics<N> *amaf) const {
+        return amaf ? select<MINIMISE, true>(n, logN, uct_temperature, prior_exploration, amaf)
+                    : select<MINIMISE, false>(n, logN, uct_temperature, prior_exploration, amaf);
+    }
+
+    template <bool MINIMISE, bool RAVE>
+    uint select(uint n, float logN, float uct_temperature, float prior_exploration, const AmafStatistics<N> *amaf) const {
+        // The atomics are read by a scalar loop, the scores are computed by one that the compiler can vectorize
+        float visited[N], score_sums[N], pending[N], inverse_sqrt[N], excluded[N], prior_terms[N], values[N];
+        float amaf_visited[RAVE ? N : 1], amaf_sums[RAVE ? N : 1], betas[RAVE ? N : 1];
+        const float prior_weight = prior_exploration / PRIOR_UNIT;
+        for (uint i = 0; i < n; ++i) {
+            const std::uint64_t entry = entries[i].load(std::memory_order_relaxed);
+            const uint v = unpack_visits(entry), p = virtual_visits[i].load(std::memory_order_relaxed);
+            visited[i] = float(int(v));
+            score_sums[i] = float(int(unpack_score(entry)));
+            pending[i] = float(int(p));
+            inverse_sqrt[i] = inverse_sqrt_visits(v + p);
+            excluded[i] = is_proven(i) ? -std::numeric_limits<float>::infinity() : 0;
+            prior_terms[i] = prior_weight * float(priors[i]);
+            if constexpr (RAVE) {
+                // An edge without all-moves-as-first visits keeps its own average
+                const uint a = amaf->visits[i].load(std::memory_order_relaxed);
+                amaf_visited[i] = float(int(std::max(a, 1u)));
+                amaf_sums[i] = float(int(amaf->scores[i].load(std::memory_order_relaxed)));
+                betas[i] = a ? rave_beta(v) : 0;
+            }
+        }
+
+        constexpr float SIGN = MINIMISE ? -1 : 1;
+        const float exploration = uct_temperature * std::sqrt(logN);
+        for (uint i = 0; i < n; ++i) {
+            const float inverse = inverse_sqrt[i] * inverse_sqrt[i];
+            float average = score_sums[i] / visited[i];
+            if constexpr (RAVE) average += betas[i] * (amaf_sums[i] / amaf_visited[i] - average);
+            values[i] = (SIGN * average - pending[i] * VIRTUAL_LOSS * inverse) * UCT_SCORE_MULTIPLIER +
+                        exploration * inverse_sqrt[i] + prior_terms[i] / (1 + visited[i] + pending[i]) + excluded[i];
+        }
+
+        uint best = NO_EDGE;
+        float best_value = -std::numeric_limits<float>::infinity();
+        for (uint i = 0; i < n; ++i) {
+            if (values[i] > best_value) {
+                best_value = values[i];
+                best = i;
+            }
+        }
+        return best;
+    }
+
+    // Position of the first edge with the best value of the first `n`, the proven value of the child when there is
+    // one and the average otherwise
+    template <bool MINIMISE, typename ProvenValueOf>
+    uint best(uint n, ProvenValueOf &&proven_value) const {
+        uint best = 0;
+        float best_score = -std::numeric_limits<float>::infinity();
+        for (uint i = 0; i < n; ++i) {
+            const float value = is_proven(i) ? std::forward<ProvenValueOf>(proven_value)(i) : average_score(i);
+            const float s = MINIMISE ? -value : value;
+            if (s > best_score) {
+                best_score = s;
+                best = i;
+            }
+        }
+        return best;
+    }
+};
+
+// An order move is identified by its destination and sliding direction, the chip that slides is the first one behind it
+constexpr inline uint ORDER_EDGE_KEYS = BOARD_AREA * 4 + 1;
+
+inline uint order_edge_key(OrderMove::Compact move) {
+    if (move.is_pass()) return ORDER_EDGE_KEYS - 1;
+
+    const bool horizontal = move.from / BOARD_SIZE == move.to / BOARD_SIZE;
+    return move.to * 4u + horizontal * 2u + (move.to > move.from);
+}
+
+// Inverse of order_edge_key on the board the move is made on
+inline OrderMove::Compact order_edge_move(const MinimalBoardState &board, uint key) {
+    OrderMove::Compact move;
+    if (key == ORDER_EDGE_KEYS - 1) {
+        move.make_pass();
+        return move;
+    }
+
+    const uint to = key / 4;
+    const int step = (key & 2 ? 1 : int(BOARD_SIZE)) * (key & 1 ? -1 : 1);
+    uint from = to + step;
+    while (!board.read_chip(from / BOARD_SIZE, from % BOARD_SIZE)) from += step;
+    return {from, to};
+}
+
+// The moves of one iteration below the root, the tree path followed by the rollout, for the all-moves-as-first
+// statistics of the nodes on the path and for the move values of MoveValueTable. Order moves without the passes,
+// placements by cell and colour.
+struct SimulationMoves {
+    void add(OrderMove::Compact move) {
+        if (!move.is_pass()) order_moves[order_count++] = move;
+    }
+
+    void add(ChaosMove placement) {
+        chaos_cells[chaos_count] = uint8_t(placement.pos.p);
+        chaos_colours[chaos_count++] = placement.colour;
+    }
+
+    OrderMove::Compact order_moves[BOARD_AREA + 1];
+    uint8_t chaos_cells[BOARD_AREA + 1];
+    Colour chaos_colours[BOARD_AREA + 1];
+    uint order_count = 0;
+    uint chaos_count = 0;
+};
+
+// Probability that a MAST rollout move ignores the immediate score and plays the move with the best value instead
+constexpr inline float MAST_EXPLORATION = 1. / 16;
+
+// Width of the noise on the move values of a MAST rollout in points, a move whose value is the best by less than that
+// is not always chosen
+constexpr inline float MAST_NOISE = 6;
+
+// Move-average sampling technique: the average score of the iterations that played a move anywhere, per from and to
+// of an order move and per cell and colour of a placement, kept for the whole game and shared by every thread. An
+// entry packs the visits in its low VISIT_BITS bits and the score sum above them, so a score is recorded by one
+// relaxed fetch_add without a lock. MoveMaker halves the entries before each of its searches, which keeps the visits of
+// an entry within twice the iterations of a search and ages the values of the earlier positions.
+class MoveValueTable {
+public:
+    // Average score of the move, the average of every recorded iteration while it has none
+    float order_value(OrderMove::Compact move, float unknown) const {
+        return move.is_pass() ? unknown : value(order_entries[move.from * BOARD_AREA + move.to], unknown);
+    }
+
+    float chaos_value(Position p, Colour colour, float unknown) const {
+        return value(chaos_entries[p.p * BOARD_COLOURS + colour], unknown);
+    }
+
+    float mean() const { return value(total, 0); }
+
+    void record(const SimulationMoves &moves, uint score) {
+        const std::uint64_t entry = 1 | std::uint64_t(score) << VISIT_BITS;
+        for (uint i = 0; i < moves.order_count; ++i) {
+            order_entries[moves.order_moves[i].from * BOARD_AREA + moves.order_moves[i].to].fetch_add(entry, std::memory_order_relaxed);
+        }
+        for (uint i = 0; i < moves.chaos_count; ++i) {
+            chaos_entries[moves.chaos_cells[i] * BOARD_COLOURS + moves.chaos_colours[i]].fetch_add(entry, std::memory_order_relaxed);
+        }
+        total.fetch_add(entry, std::memory_order_relaxed);
+    }
+
+    // Not safe while other threads record
+    void decay() {
+        for (auto &entry : order_entries) halve(entry);
+        for (auto &entry : chaos_entries) halve(entry);
+        halve(total);
+    }
 
 private:
-    void tree_search_helper(OrderNode *order_node, ChaosNode *chaos_root = nullptr, Colour root_colour = 0);
+    static constexpr uint VISIT_BITS = 24;
+    static constexpr std::uint64_t VISITS_MASK = (std::uint64_t(1) << VISIT_BITS) - 1;
+
+    static float value(const std::atomic<std::uint64_t> &entry, float unknown) {
+        const std::uint64_t e = entry.load(std::memory_order_relaxed);
+        return e & VISITS_MASK ? float(e >> VISIT_BITS) / float(e & VISITS_MASK) : unknown;
+    }
+
+    static void halve(std::atomic<std::uint64_t> &entry) {
+        const std::uint64_t e = entry.load(std::memory_order_relaxed), visits = (e & VISITS_MASK) / 2;
+        entry.store(visits ? visits | (e >> VISIT_BITS) / 2 << VISIT_BITS : 0, std::memory_order_relaxed);
+    }
+
+    std::atomic<std::uint64_t> order_entries[BOARD_AREA * BOARD_AREA]{};
+    std::atomic<std::uint64_t> chaos_entries[BOARD_AREA * BOARD_COLOURS]{};
+    std::atomic<std::uint64_t> total{};
+};
+
+// Children of a chaos node for one colour, taken from an arena when the colour is first expanded
+struct ChaosEdges {
+    ChaosEdges(const MinimalBoardState &board, Colour colour, bool progressive_widening, NodeIndex amaf) : amaf(amaf) {
+        std::fill_n(edge_slots, BOARD_AREA, NO_EDGE);
+        float gains[BOARD_AREA];
+        board.for_each_possible_chaos_move_with_score(colour, [this, &gains](Position p, uint score) {
+            gains[unvisited.size()] = float(score);
+            unvisited.push(p.p);
+        });
+        unvisited.sort(gains, -1, CHAOS_PRIOR_SCALE, progressive_widening, RNG);
+        cells = uint8_t(unvisited.size());
+    }
+
+    // Proves the minimum over the cells once every cell has a proven child
+    bool try_solve(SearchEnvironment &environment);
+
+    // Position of the edge UCT descends, NO_EDGE while no edge is published
+    uint select_edge(float logN, float uct_temperature, float prior_exploration, const ChaosAmafStatistics *amaf_statistics) const {
+        const uint n = published.load(std::memory_order_acquire);
+        return n ? statistics.select<true>(n, logN, uct_temperature, prior_exploration, amaf_statistics) : NO_EDGE;
+    }
+
+    // Records `score` for the edges of the placements of `moves` from `first` on that have `colour`, the colour of the edges
+    void record_amaf(SearchEnvironment &environment, const SimulationMoves &moves, uint first, Colour colour, uint score);
+
+    Edge<uint8_t> edges[BOARD_AREA];
+    uint8_t edge_slots[BOARD_AREA];// edge position per cell
+    std::atomic<uint> published{};
+    EdgeStatistics<BOARD_AREA> statistics;
+
+    ExpansionQueue<BOARD_AREA> unvisited;// cells
+    uint8_t cells;
+
+    const NodeIndex amaf;// into the SearchEnvironment's chaos AMAF arena, NULL_NODE without RAVE
+
+    ProvenValue solved;
 };
 
+using ChaosEdgesArena = NodeArena<ChaosEdges>;
+
+// All members that are used during a search are safe to call from multiple threads at once.
+// Children become visible to select_child once their first rollout has been recorded.
+// Every edge holds one reference to its child in the SearchEnvironment's arenas.
 class OrderNode {
 public:
     OrderNode() = delete;
@@ -59,57 +512,78 @@ public:
     OrderNode(const BoardState &b,
               const ChipPool &pool) : board(b), pool(pool) {}
 
-    OrderNode(ChaosNode *p,
+    OrderNode(const ChaosNode &parent,
               const ChaosMove &new_move);
 
-    ~OrderNode();
-
-    std::shared_ptr<ChaosNode> *get_child(const OrderMove &move) {
-        auto it = std::find_if(children.begin(), children.end(),
-                               [=](const auto &x) { return move == x->parents[this]; });
-        if (it == children.end()) return nullptr;
-        return &*it;
+    NodeIndex get_child(const OrderMove &move) const {
+        const uint8_t slot = edge_slots[order_edge_key(move)];
+        return slot == NO_EDGE ? NULL_NODE : edges[slot].node;
     }
 
-    ChaosNode *add_random_child(SearchEnvironment &environment);
+    // Expands the next move of the expansion order unless progressive widening holds it back, the move and the moves
+    // of the rollout are appended to `moves` when it is given
+    bool try_add_child(SearchEnvironment &environment, uint &rollout_score, SimulationMoves *moves = nullptr);
 
-    ChaosNode *select_child(float uct_temperature) const;
+    // Position of the edge UCT descends, NO_EDGE while no unproven edge is published
+    uint select_edge(const SearchEnvironment &environment) const;
 
-    ChaosNode *select_best_node() const;
+    // Proves the maximum over the moves once every move has a proven child
+    bool try_solve(SearchEnvironment &environment);
 
-    uint rollout() const { return smart_rollout_order(board, pool); }
+    const ProvenValue &get_proven_value() const { return solved; }
 
-    bool can_add_child() const { return unvisited; }
+    const Edge<OrderMove::Compact> &select_best_edge(SearchEnvironment &environment) const;
 
-    void try_init() {
-        if (!initialized) init();
+    // Average of `n` playouts cut off after `cut_after` chips, full playouts are played in lockstep by rollout_batch,
+    // which is always greedy. The moves of a single playout are appended to `moves` when it is given.
+    uint rollout(uint n, uint cut_after, SimulationMoves *moves = nullptr, const MoveValueTable *policy = nullptr) const {
+        if (n == 1) return smart_rollout_order(board, pool, cut_after, moves, policy);
+        if (cut_after < board.get_open_cells()) return cut_rollouts(board, pool, n, cut_after, policy, smart_rollout_order);
+        return (rollout_batch(board, pool, n, false) + n / 2) / n;
     }
 
-    float average_score() const { return float(total_score) / float(total_visits); }
+    // Records `score` for the edges of the order moves of `moves` from `first` on
+    void record_amaf(SearchEnvironment &environment, const SimulationMoves &moves, uint first, uint score);
 
-    float branch_score(const float logN, float uct_temperature) const {
-        return uct_score(-average_score(), logN, float(total_visits), uct_temperature);
+    void try_init(const SearchEnvironment &environment) {
+        if (!initialized.load(std::memory_order_acquire)) {
+            std::lock_guard lock(expansion_lock);
+            if (!initialized.load(std::memory_order_relaxed)) init(environment);
+        }
     }
 
+    uint get_total_visits() const { return total_visits; }
+
+    uint get_children() const { return published.load(std::memory_order_acquire); }
+
+    float average_score() const { return float(total_score) / float(total_visits); }
+
 private:
-    void init();
+    void init(const SearchEnvironment &environment);
 
     void record_score(uint score);
 
-    void add_parent(ChaosNode *parent, const ChaosMove &move);
-
     BoardState board;
     const ChipPool pool;
-    std::map<ChaosNode *, ChaosMove> parents{};
-    std::vector<std::shared_ptr<ChaosNode>> children;
 
-    uint total_visits{};
-    uint total_score{};
+    // Published in the order their first rollout finished, `edge_slots` maps an edge key to the position
+    Edge<OrderMove::Compact> edges[MAX_POSSIBLE_ORDER_MOVES];
+    uint8_t edge_slots[ORDER_EDGE_KEYS];
+    std::atomic<uint> published{};
+    EdgeStatistics<MAX_POSSIBLE_ORDER_MOVES> statistics;
+
+    std::atomic<uint> total_visits{};
+    std::atomic<uint> total_score{};
+
+    ExpansionQueue<MAX_POSSIBLE_ORDER_MOVES> unvisited;// edge keys
+    uint8_t moves = 0;
+
+    NodeIndex amaf = NULL_NODE;// into the SearchEnvironment's order AMAF arena, taken by init with RAVE
 
-    OrderMove::Compact moves[MAX_POSSIBLE_ORDER_MOVES];
-    uint unvisited{};
+    ProvenValue solved;
 
-    bool initialized = false;
+    SpinLock expansion_lock;
+    std::atomic<bool> initialized = false;
 
     friend SearchEnvironment;
     friend ChaosNode;
@@ -121,179 +595,502 @@ public:
     ChaosNode() = delete;
 
     ChaosNode(const BoardState &b,
-              const ChipPool &pool) : board(b), pool(pool) {}
+              const ChipPool &pool) : board(b), pool(pool) {
+        colour_edges.fill(NULL_NODE);
+        if (is_terminal()) solved.set(float(board.get_total_score()));
+    }
 
-    ChaosNode(OrderNode *p,
+    ChaosNode(const OrderNode &parent,
               const OrderMove &new_move);
 
-    ~ChaosNode() {
-        for (auto &vec : children) {
-            destruct_children(vec);
-        }
-    }
+    NodeIndex get_child(SearchEnvironment &environment, const ChaosMove &move) const;
 
-    std::shared_ptr<OrderNode> *get_child(const ChaosMove &move) {
-        auto &vec = children[move.colour - 1];
-        auto it = std::find_if(vec.begin(), vec.end(),
-                               [=](const auto &x) { return move.pos.p == x->parents[this].pos.p; });
-        if (it == vec.end()) return nullptr;
-        return &*it;
-    }
-
-    OrderNode *add_random_child(Colour colour, SearchEnvironment &environment);
+    bool try_add_child(Colour colour, SearchEnvironment &environment, uint &rollout_score, SimulationMoves *moves = nullptr);
 
-    OrderNode *select_child(Colour colour, float uct_temperature) const;
+    // Edges of `colour`, null until the colour is first expanded
+    ChaosEdges *get_edges(Colour colour, SearchEnvironment &environment) const;
 
-    OrderNode *select_best_node(Colour colour) const;
+    uint select_edge(Colour colour, SearchEnvironment &environment) const;
 
-    uint rollout() const { return smart_rollout_chaos(board, pool); }
+    const Edge<uint8_t> &select_best_edge(Colour colour, SearchEnvironment &environment) const;
 
-    bool can_add_child(Colour colour) const { return !unvisited_moves[colour - 1].empty(); }
+    // Proves the expectation over the colours left in the pool once every one of them is proven
+    bool try_solve(SearchEnvironment &environment);
 
-    void try_init() {
-        if (!initialized) init();
+    bool try_solve(Colour colour, SearchEnvironment &environment) {
+        const auto edges = get_edges(colour, environment);
+        return edges && edges->try_solve(environment);
     }
 
-    float average_score() const { return float(total_score) / float(total_visits); }
+    const ProvenValue &get_proven_value() const { return solved; }
 
-    float branch_score(const float logN, float uct_temperature) const {
-        return uct_score(average_score(), logN, float(total_visits), uct_temperature);
+    uint rollout(uint n, uint cut_after, SimulationMoves *moves = nullptr, const MoveValueTable *policy = nullptr) const {
+        if (n == 1) return smart_rollout_chaos(board, pool, cut_after, moves, policy);
+        if (cut_after < board.get_open_cells()) return cut_rollouts(board, pool, n, cut_after, policy, smart_rollout_chaos);
+        return (rollout_batch(board, pool, n, true) + n / 2) / n;
     }
 
+    uint get_total_visits() const { return total_visits; }
+
+    // Mean of the averages of the colours weighted by their chips, over the colours with visits, the plain average
+    // before any colour has one. This is the value that the edge from the parent holds.
+    float average_score() const;
+
     bool is_terminal() const { return !board.get_open_cells(); }
 
     Colour random_colour() const { return pool.random_chip(RNG); }
 
-    void clear_colours(uint keep) {
-        for (uint c = 0; c < children.size(); ++c) {
-            if (c == keep - 1) continue;
-            unvisited_moves[c] = {};
-
-            destruct_children(children[c]);
+    // The colour whose visits fall the furthest behind its share of the chips, so that the visits of the colours
+    // follow the probabilities of the draw without its noise. Ties go to the lowest colour.
+    Colour scheduled_colour() const;
 
-            total_visits -= visits[c];
-            total_score -= scores[c];
-
-            scores[c] = 0;
-            visits[c] = 0;
-        }
-    }
+    void clear_colours(SearchEnvironment &environment, uint keep);
 
 private:
-    void init();
-
     void record_score(uint score, Colour colour);
 
-    void add_parent(OrderNode *parent, const OrderMove &move);
-
-    void destruct_children(std::vector<std::shared_ptr<OrderNode>> &vec);
+    uint colour_visits(Colour colour) const { return unpack_visits(colour_entries[colour - 1].load(std::memory_order_relaxed)); }
 
     BoardState board;
     const ChipPool pool;
-    std::map<OrderNode *, OrderMove> parents{};
-    std::array<std::vector<std::shared_ptr<OrderNode>>, ChipPool::N> children{};
 
-    std::array<uint, ChipPool::N> visits{};
-    uint total_visits{};
-    std::array<uint, ChipPool::N> scores{};
-    uint total_score{};
+    // Index into the SearchEnvironment's chaos edge arena, NULL_NODE until the colour is first expanded
+    std::array<NodeIndex, ChipPool::N> colour_edges;
+
+    // Visits and score sums of the colours, see pack_visits
+    std::array<std::atomic<std::uint64_t>, ChipPool::N> colour_entries{};
+    std::atomic<uint> total_visits{};
+    std::atomic<uint> total_score{};
 
-    std::array<std::vector<uint8_t>, ChipPool::N> unvisited_moves{};
+    ProvenValue solved;
 
-    bool initialized = false;
+    SpinLock expansion_lock;
 
     friend SearchEnvironment;
     friend OrderNode;
     friend MoveMaker;
 };
 
+struct SolverStatistics {
+    std::size_t iterations = 0;
+    std::size_t proven_hits = 0;   // iterations that ended at a proven node instead of a rollout
+    std::size_t saved_iterations = 0;// not searched because the root was proven, extrapolated up to the deadline
+
+    SolverStatistics &operator+=(const SolverStatistics &o) {
+        iterations += o.iterations;
+        proven_hits += o.proven_hits;
+        saved_iterations += o.saved_iterations;
+        return *this;
+    }
+};
+
+enum class Parallelism : uint8_t {
+    ROOT,// every thread searches its own tree, the root statistics are merged afterwards
+    TREE,// all threads descend the same tree, spread out by virtual loss
+};
+
+// The configuration of a search, which the helpers of a root parallel search copy as a whole
+struct SearchSettings {
+    float uct_temperature = 0.45;
+    uint rollouts = 8'500;// upper bound, a search normally stops at the deadline
+    Clock::time_point deadline = Clock::time_point::max();
+    uint threads = 1;
+    Parallelism parallelism = Parallelism::ROOT;
+    // Both per tree, a root parallel search holds one tree per thread
+    std::size_t transposition_table_bytes = TRANSPOSITION_TABLE_BYTES;
+    std::size_t node_memory_bytes = NODE_MEMORY_BYTES;// hard cap, the search stops expanding when it is reached
+    bool huge_pages = false;
+    uint leaf_rollouts = 1;// playouts averaged into the score of a new leaf
+    uint rollout_chips = 2;// chips a playout places before the value function estimates the rest, BOARD_AREA for none
+    bool progressive_widening = true;// children in prior order as the visits grow, otherwise all of them in random order first
+    bool rave = false;// blends all-moves-as-first averages into the selection, see benchmark_rave. Sizes the arenas.
+    bool mast = false;// rollouts follow the move values of move_values, see benchmark_mast
+    bool stratified_colours = true;// chance nodes take scheduled_colour instead of drawing, see benchmark_stratified_colours
+};
+
+// Aggregate initialized like SearchSettings, whose fields come first
+struct SearchEnvironment : SearchSettings {
+    // Heap allocated so that node addresses stay valid when the environment is moved.
+    // The cap is split so that every arena holds the same amount of nodes, every chaos edge block has at least
+    // one order node child, so it never needs more slots than the order nodes. The AMAF arenas get a share with RAVE.
+    std::unique_ptr<OrderNodeArena> order_arena = std::make_unique<OrderNodeArena>(arena_memory<OrderNode>(), huge_pages);
+    std::unique_ptr<ChaosNodeArena> chaos_arena = std::make_unique<ChaosNodeArena>(arena_memory<ChaosNode>(), huge_pages);
+    std::unique_ptr<ChaosEdgesArena> chaos_edges_arena = std::make_unique<ChaosEdgesArena>(arena_memory<ChaosEdges>(), huge_pages);
+    std::unique_ptr<OrderAmafArena> order_amaf_arena = std::make_unique<OrderAmafArena>(arena_memory<OrderAmafStatistics>(), huge_pages);
+    std::unique_ptr<ChaosAmafArena> chaos_amaf_arena = std::make_unique<ChaosAmafArena>(arena_memory<ChaosAmafStatistics>(), huge_pages);
+
+    std::unique_ptr<TranspositionTable<OrderNode>> order_table = std::make_unique<TranspositionTable<OrderNode>>(*order_arena, transposition_table_bytes / 2);
+    std::unique_ptr<TranspositionTable<ChaosNode>> chaos_table = std::make_unique<TranspositionTable<ChaosNode>>(*chaos_arena, transposition_table_bytes / 2);
+
+    // Shared with the helpers of a root parallel search
+    std::shared_ptr<MoveValueTable> move_values = std::make_shared<MoveValueTable>();
+
+    SolverStatistics solver_statistics{};// of the searches since the last report_statistics
+
+    OrderNode &order_node(NodeIndex index) { return (*order_arena)[index]; }
+
+    ChaosNode &chaos_node(NodeIndex index) { return (*chaos_arena)[index]; }
+
+    ChaosEdges &chaos_edges(NodeIndex index) { return (*chaos_edges_arena)[index]; }
+
+    // Null when `index` is NULL_NODE
+    const OrderAmafStatistics *order_amaf(NodeIndex index) const { return index == NULL_NODE ? nullptr : &(*order_amaf_arena)[index]; }
+
+    const ChaosAmafStatistics *chaos_amaf(NodeIndex index) const { return index == NULL_NODE ? nullptr : &(*chaos_amaf_arena)[index]; }
+
+    // Weight of the priors in the selection at a node with `visits` visits
+    float prior_exploration(uint visits) const { return progressive_widening ? PRIOR_WEIGHT * std::sqrt(float(visits)) : 0; }
+
+    const MoveValueTable *rollout_policy() const { return mast ? move_values.get() : nullptr; }
+
+    // Colour of the chip that an iteration draws at `node`
+    Colour next_colour(const ChaosNode &node) const { return stratified_colours ? node.scheduled_colour() : node.random_colour(); }
+
+    // Returns a new reference to the child reached by `move`, shared with other parents when it is in the transposition table
+    NodeIndex get_order_node(const ChaosNode &parent, const ChaosMove &move);
+
+    NodeIndex get_chaos_node(const OrderNode &parent, const OrderMove &move);
+
+    void release_order_node(NodeIndex index);
+
+    void release_chaos_node(NodeIndex index);
+
+    void release_chaos_edges(NodeIndex index);
+
+    void release_order_amaf(NodeIndex index);
+
+    void release_chaos_amaf(NodeIndex index);
+
+    // Prints the node memory usage, the transposition table and the solver statistics, the latter two are restarted
+    void report_statistics();
+
+    // Whether a new root and all of its children still fit in the node memory
+    bool has_room_for_root() const {
+        return order_arena->remaining_nodes() > MAX_POSSIBLE_ORDER_MOVES &&
+               chaos_arena->remaining_nodes() > MAX_POSSIBLE_ORDER_MOVES &&
+               chaos_edges_arena->remaining_nodes() > ChipPool::N;
+    }
+
+    // Drops every node in O(1) instead of releasing the trees one by one, all indices become invalid
+    void reset() {
+        order_arena->reset();
+        chaos_arena->reset();
+        chaos_edges_arena->reset();
+        order_amaf_arena->reset();
+        chaos_amaf_arena->reset();
+    }
+
+    void tree_search_order(OrderNode &root);
+
+    void tree_search_chaos(ChaosNode &root, Colour c);
+
+    // Keeps searching on the opponent's turn until `stop` is set or the rollout cap is reached
+    void ponder(OrderNode &root, const std::atomic<bool> &stop);
+
+    void ponder(ChaosNode &root, const std::atomic<bool> &stop);
+
+    bool out_of_time(uint iteration) const {
+        return !(iteration % CLOCK_CHECK_INTERVAL) && Clock::now() >= deadline;
+    }
+
+private:
+    uint thread_rollouts() const { return (rollouts + threads - 1) / threads; }
+
+    template <typename T>
+    std::size_t arena_memory() const {
+        const std::size_t amaf_bytes = rave ? sizeof(OrderAmafStatistics) + sizeof(ChaosAmafStatistics) : 0;
+        return node_memory_bytes / (sizeof(OrderNode) + sizeof(ChaosNode) + sizeof(ChaosEdges) + amaf_bytes) * sizeof(T);
+    }
+
+    // Runs `iteration` until `limit`, the deadline, or until `solved` returns true.
+    // `iteration` returns whether it ended at a proven node.
+    template <typename Iteration, typename Solved>
+    SolverStatistics search_loop(uint limit, Iteration &&iteration, Solved &&solved) const {
+        SolverStatistics result;
+        for (uint i = 0; i < limit && !out_of_time(i) && !std::forward<Solved>(solved)(); ++i) {
+            result.proven_hits += std::forward<Iteration>(iteration)();
+            ++result.iterations;
+        }
+        return result;
+    }
+
+    // Counts the iterations that a search begun at `start` with `iterations` so far does not need, its root is proven
+    void record_proven_root(Clock::time_point start, std::size_t iterations);
+
+    template <typename HelperSearch, typename Iteration, typename Solved>
+    void root_parallel_search(HelperSearch &&helper_search, Iteration &&iteration, Solved &&solved);
+
+    template <typename Solved>
+    void root_parallel_order(OrderNode &root, Solved &&solved);
+
+    template <typename Solved>
+    void root_parallel_chaos(ChaosNode &root, Colour c, Solved &&solved);
+
+    template <typename Iteration, typename Solved>
+    void tree_parallel_search(Iteration &&iteration, Solved &&solved);
+
+    bool shares_tree() const { return threads > 1 && parallelism == Parallelism::TREE; }
+
+    // Descends from `order_root`, or from the child of `chaos_root` chosen for `root_colour` when it is null.
+    // Returns whether the score is a proven value instead of a rollout.
+    bool tree_search_helper(OrderNode *order_root, ChaosNode *chaos_root = nullptr, Colour root_colour = 0);
+};
+
 class MoveMaker final : public entropy::MoveMaker {
 public:
-    explicit MoveMaker(SearchEnvironment environment = {}) : search_environment(std::move(environment)) {
+    // Positions with at most `endgame_open_cells` open cells are solved exactly instead of searched
+    explicit MoveMaker(SearchEnvironment environment = {},
+                       TimeManager time_manager = {},
+                       uint endgame_open_cells = ENDGAME_OPEN_CELLS) : search_environment(std::move(environment)),
+                                                                       time_manager(time_manager),
+                                                                       endgame_open_cells(endgame_open_cells) {
         std::cerr << "MCTS Seed: " << RNG.seed << '\n';
     }
 
+    ~MoveMaker() { stop_pondering(); }
+
     ChaosMove suggest_chaos_move(Colour colour) override {
-        if (!chaos_node) chaos_node = chaos_node_buffer.make_shared(board, chip_pool);
-        else chaos_node->clear_colours(uint(colour));
+        stop_pondering();
+        if (board.get_open_cells() <= endgame_open_cells) return solve_chaos_move(colour);
+        search_environment.deadline = time_manager.start_move(board.get_open_cells());
+        if (Position pos; find_book_chaos_move(board, colour, pos)) {
+            std::cerr << colour << pos << " : book move\n";
+            time_manager.end_move();
+            return {pos, colour};
+        }
+        release_old_roots();
+        if (search_environment.mast) search_environment.move_values->decay();
+
+        ensure_room_for_root();
+        if (chaos_root == NULL_NODE) chaos_root = search_environment.chaos_arena->create(board, chip_pool);
+        auto &root = search_environment.chaos_node(chaos_root);
+        root.clear_colours(search_environment, uint(colour));
 
-        std::cerr << "cached visits = " << chaos_node->total_visits << '\n';
-        search_environment.tree_search_chaos(*chaos_node, colour);
+        std::cerr << "cached visits = " << root.total_visits << '\n';
+        search_environment.tree_search_chaos(root, colour);
 
-        auto node = chaos_node->select_best_node(colour);
-        auto move = node->parents[chaos_node.get()];
+        const auto &edge = root.select_best_edge(colour, search_environment);
+        const auto node = &search_environment.order_node(edge.node);
+        const ChaosMove move{edge.move, colour};
 
         std::cerr << move.colour << move.pos;
         std::cerr << " : "
-                  << "total visits = " << chaos_node->total_visits << "; node visits = " << node->total_visits << "; expected score = " << node->average_score() << '\n';
+                  << "total visits = " << root.total_visits << "; node visits = " << node->total_visits << "; expected score = " << node->average_score() << '\n';
 
-        return node->parents[chaos_node.get()];
+        report_statistics();
+        time_manager.end_move();
+        return move;
     }
 
     OrderMove suggest_order_move() override {
-        if (!order_node) order_node = order_node_buffer.make_shared(board, chip_pool);
-
-        std::cerr << "cached visits = " << order_node->total_visits << '\n';
-        search_environment.tree_search_order(*order_node);
-
-        /*
-        float logN = std::log(float(order_node->total_visits));
-
-        for (const auto &c : order_node->children) {
-            auto move = c->parents[order_node.get()];
-
+        stop_pondering();
+        if (board.get_open_cells() <= endgame_open_cells) return solve_order_move();
+        search_environment.deadline = time_manager.start_move(board.get_open_cells());
+        if (OrderMove move; find_book_order_move(board, move)) {
             if (move.is_pass()) std::cerr << "PASS";
             else std::cerr << move.from << move.to;
-            std::cerr << " : " << c->branch_score(logN, search_environment.uct_temperature) << " " << c->total_visits << " " << c->average_score() << '\n';
+            std::cerr << " : book move\n";
+            time_manager.end_move();
+            return move;
         }
-        */
+        release_old_roots();
+        if (search_environment.mast) search_environment.move_values->decay();
+
+        ensure_room_for_root();
+        if (order_root == NULL_NODE) order_root = search_environment.order_arena->create(board, chip_pool);
+        auto &root = search_environment.order_node(order_root);
 
-        auto node = order_node->select_best_node();
-        auto move = node->parents[order_node.get()];
+        std::cerr << "cached visits = " << root.total_visits << '\n';
+        search_environment.tree_search_order(root);
+
+        const auto &edge = root.select_best_edge(search_environment);
+        const auto node = &search_environment.chaos_node(edge.node);
+        const OrderMove move = edge.move.create();
 
         if (move.is_pass()) std::cerr << "PASS";
         else std::cerr << move.from << move.to;
 
         std::cerr << " : "
-                  << "total visits = " << order_node->total_visits << "; node visits = " << node->total_visits << "; expected score = " << node->average_score() << '\n';
+                  << "total visits = " << root.total_visits << "; node visits = " << node->total_visits << "; expected score = " << node->average_score() << '\n';
 
+        report_statistics();
+        time_manager.end_move();
         return move;
     }
 
     void register_chaos_move(const ChaosMove &move) override {
+        const bool pondered = stop_pondering();
+
         board.place_chip(move);
         chip_pool = ChipPool(chip_pool, move.colour);
 
-        if (chaos_node) {
-            auto ptr = chaos_node->get_child(move);
+        if (chaos_root != NULL_NODE) {
+            order_root = search_environment.chaos_node(chaos_root).get_child(search_environment, move);
 
-            if (ptr) order_node = *ptr;
-            else order_node = nullptr;
-
-            chaos_node = nullptr;
+            // Without a matching child nothing is reused, so every node is dropped at once
+            if (order_root == NULL_NODE) reset_tree();
+            else {
+                search_environment.order_arena->add_reference(order_root);
+                released_chaos_root = chaos_root;
+            }
+            chaos_root = NULL_NODE;
         }
+
+        if (pondered) report_ponder_result(order_root != NULL_NODE ? search_environment.order_node(order_root).get_total_visits() : 0);
     }
 
     void register_order_move(const OrderMove &move) override {
+        const bool pondered = stop_pondering();
+
         board.move_chip(move);
 
-        if (order_node) {
-            auto ptr = order_node->get_child(move);
+        if (order_root != NULL_NODE) {
+            chaos_root = search_environment.order_node(order_root).get_child(move);
+
+            if (chaos_root == NULL_NODE) reset_tree();
+            else {
+                search_environment.chaos_arena->add_reference(chaos_root);
+                released_order_root = order_root;
+            }
+            order_root = NULL_NODE;
+        }
 
-            if (ptr) chaos_node = *ptr;
-            else chaos_node = nullptr;
+        if (pondered) report_ponder_result(chaos_root != NULL_NODE ? search_environment.chaos_node(chaos_root).get_total_visits() : 0);
+    }
 
-            order_node = nullptr;
+    void start_pondering() override {
+        stop_pondering();
+        stop_ponder = false;
+
+        const FastRand::result_type seed = RNG() << 16 ^ RNG();
+        if (order_root != NULL_NODE) {
+            ponder_thread = std::thread([this, seed] {
+                RNG.seed = seed;
+                release_old_roots();
+                search_environment.ponder(search_environment.order_node(order_root), stop_ponder);
+            });
+        } else if (chaos_root != NULL_NODE) {
+            ponder_thread = std::thread([this, seed] {
+                RNG.seed = seed;
+                release_old_roots();
+                search_environment.ponder(search_environment.chaos_node(chaos_root), stop_ponder);
+            });
         }
     }
 
 private:
+    SearchEnvironment search_environment;// owns the node arenas
+    TimeManager time_manager;
+
     BoardState board;
     ChipPool chip_pool;
-    std::shared_ptr<OrderNode> order_node{};
-    std::shared_ptr<ChaosNode> chaos_node{};
+    NodeIndex order_root = NULL_NODE;
+    NodeIndex chaos_root = NULL_NODE;
+
+    // Promoting a child only adds a reference, the rest of the old tree is released on the opponent's time
+    NodeIndex released_order_root = NULL_NODE;
+    NodeIndex released_chaos_root = NULL_NODE;
+
+    EndgameSolver endgame_solver;
+    uint endgame_open_cells;
+
+    std::thread ponder_thread{};
+    std::atomic<bool> stop_ponder = false;
+    uint pondered_moves = 0;
+    uint ponder_hits = 0;
 
-    SearchEnvironment search_environment;
+    // Rollouts that proven values made unnecessary, per move of the last SAVED_ITERATION_MOVES
+    constexpr static uint SAVED_ITERATION_MOVES = 10;
+    std::array<std::size_t, SAVED_ITERATION_MOVES> saved_iterations{};
+    uint searched_moves = 0;
+
+    ChaosMove solve_chaos_move(Colour colour) {
+        time_manager.start_move(board.get_open_cells());
+        drop_tree();
+
+        const auto begin = Clock::now();
+        const auto solution = endgame_solver.solve_chaos(board, chip_pool, colour);
+        const ChaosMove move{solution.move, colour};
+
+        std::cerr << move.colour << move.pos << " : exact score = " << solution.score << '\n';
+        report_endgame(begin);
+        time_manager.end_move();
+        return move;
+    }
+
+    OrderMove solve_order_move() {
+        time_manager.start_move(board.get_open_cells());
+        drop_tree();
+
+        const auto begin = Clock::now();
+        const auto solution = endgame_solver.solve_order(board, chip_pool);
+
+        if (solution.move.is_pass()) std::cerr << "PASS";
+        else std::cerr << solution.move.from << solution.move.to;
+        std::cerr << " : exact score = " << solution.score << '\n';
+
+        report_endgame(begin);
+        time_manager.end_move();
+        return solution.move;
+    }
+
+    // The solver decides every remaining move, so the search tree is dropped once and neither searched nor pondered again
+    void drop_tree() {
+        if (order_root != NULL_NODE || chaos_root != NULL_NODE || released_order_root != NULL_NODE || released_chaos_root != NULL_NODE) {
+            reset_tree();
+        }
+    }
+
+    void report_endgame(Clock::time_point begin) {
+        std::cerr << "endgame: nodes = " << endgame_solver.statistics.nodes << "; table hits = " << endgame_solver.statistics.table_hits
+                  << "; solved in " << millis_between(begin, Clock::now()) << "ms\n";
+        endgame_solver.statistics = {};
+    }
+
+    void release_old_roots() {
+        if (released_order_root != NULL_NODE) search_environment.release_order_node(std::exchange(released_order_root, NULL_NODE));
+        if (released_chaos_root != NULL_NODE) search_environment.release_chaos_node(std::exchange(released_chaos_root, NULL_NODE));
+    }
+
+    void ensure_room_for_root() {
+        if (search_environment.has_room_for_root()) return;
+
+        std::cerr << "node memory is full, dropping the search tree\n";
+        reset_tree();
+    }
+
+    void reset_tree() {
+        search_environment.reset();
+        order_root = chaos_root = released_order_root = released_chaos_root = NULL_NODE;
+    }
+
+    // Returns whether a ponder search was running
+    bool stop_pondering() {
+        if (!ponder_thread.joinable()) return false;
+
+        stop_ponder = true;
+        ponder_thread.join();
+        return true;
+    }
+
+    void report_statistics() {
+        const auto &solver = search_environment.solver_statistics;
+        saved_iterations[searched_moves++ % SAVED_ITERATION_MOVES] = solver.proven_hits + solver.saved_iterations;
+
+        search_environment.report_statistics();
+
+        std::size_t total = 0;
+        for (auto saved : saved_iterations) total += saved;
+        std::cerr << "solver: saved iterations in the last " << SAVED_ITERATION_MOVES << " moves = " << total << '\n';
+    }
+
+    void report_ponder_result(uint reused_visits) {
+        ++pondered_moves;
+        if (reused_visits) ++ponder_hits;
+
+        std::cerr << "ponder " << (reused_visits ? "hit" : "miss") << ": reused visits = " << reused_visits
+                  << "; hit rate = " << ponder_hits << '/' << pondered_moves << '\n';
+    }
 };
 
 
@@ -14,6 +14,9 @@ public:
 
     virtual void register_order_move(const OrderMove &) {}
 
+    // Called after a move has been sent, the opponent is thinking until the next register call
+    virtual void start_pondering() {}
+
     virtual ChaosMove suggest_chaos_move(Colour colour) = 0;
 
     virtual OrderMove suggest_order_move() = 0;
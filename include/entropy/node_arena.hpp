@@ -0,0 +1,202 @@
+#pragma once
+
+#include "data_types.hpp"
+#include "util.hpp"
+
+#include <atomic>
+#include <cstdlib>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <type_traits>
+
+#if __has_include(<sys/mman.h>)
+#include <sys/mman.h>
+#endif
+
+namespace entropy {
+
+using NodeIndex = std::uint32_t;
+
+constexpr inline NodeIndex NULL_NODE = std::numeric_limits<NodeIndex>::max();
+
+constexpr inline std::size_t PAGE_BYTES = 4096;
+constexpr inline std::size_t HUGE_PAGE_BYTES = 2 << 20;
+
+// Reference that does not keep the node alive, see NodeArena::lock
+struct WeakNodeIndex {
+    NodeIndex index = NULL_NODE;
+    std::uint32_t generation = 0;
+};
+
+struct NodeArenaStatistics {
+    std::size_t live = 0;
+    std::size_t peak = 0;
+    std::size_t free = 0;  // slots waiting in the free list
+    std::size_t failed = 0;// creations refused because the memory cap was reached
+    std::size_t reserved_bytes = 0;
+};
+
+// Typed node storage addressed by 32-bit indices, growing in chunks of one huge page up to a fixed memory cap.
+// Chunks are page aligned and, when requested, advised to be backed by transparent huge pages.
+// Nodes are reference counted inside the arena. A node is not destroyed when its count drops to zero,
+// the owner first releases whatever the node references itself and then calls `destroy`.
+// `reset` forgets every node at once, which is O(1) for trivially destructible nodes, the chunks are kept.
+template <typename T>
+class NodeArena {
+    struct Slot {
+        std::aligned_storage_t<sizeof(T), alignof(T)> storage;
+        std::atomic<std::uint32_t> references;
+        std::atomic<std::uint32_t> generation;// may be read through a stale weak index while the slot is reused
+        NodeIndex next_free;
+    };
+
+public:
+    constexpr static inline std::size_t CHUNK_BYTES = HUGE_PAGE_BYTES;
+    constexpr static inline std::size_t CHUNK_SLOTS = CHUNK_BYTES / sizeof(Slot);
+
+    explicit NodeArena(std::size_t memory_cap, bool huge_pages = false) : max_chunks(std::max<std::size_t>(memory_cap / CHUNK_BYTES, 1)),
+                                                                          chunks(new Slot *[max_chunks] {}),
+                                                                          huge_pages(huge_pages) {}
+
+    NodeArena(const NodeArena &) = delete;
+
+    ~NodeArena() {
+        destroy_all();
+        for (std::size_t c = 0; c < allocated_chunks; ++c) std::free(chunks[c]);
+    }
+
+    T &operator[](NodeIndex index) { return *std::launder(reinterpret_cast<T *>(&slot(index).storage)); }
+
+    const T &operator[](NodeIndex index) const { return *std::launder(reinterpret_cast<const T *>(&slot(index).storage)); }
+
+    // The new node starts with a single reference. Returns NULL_NODE once the memory cap is reached.
+    template <typename... Args>
+    [[nodiscard]] NodeIndex create(Args &&...args) {
+        NodeIndex index;
+        {
+            std::lock_guard lock(mutex);
+            if (free_list != NULL_NODE) {
+                index = free_list;
+                free_list = slot(index).next_free;
+                --free;
+            } else {
+                index = next.load(std::memory_order_relaxed);
+                if (index / CHUNK_SLOTS == allocated_chunks && !allocate_chunk()) {
+                    ++failed;
+                    return NULL_NODE;
+                }
+            }
+
+            // A stale weak index to this slot must not see it alive before the new node is constructed
+            slot(index).references.store(0, std::memory_order_relaxed);
+            slot(index).generation.store(++generation_counter, std::memory_order_relaxed);
+            if (index == next.load(std::memory_order_relaxed)) next.store(index + 1, std::memory_order_release);
+
+            peak = std::max(peak, ++live);
+        }
+
+        ::new (&slot(index).storage) T(std::forward<Args>(args)...);
+        slot(index).references.store(1, std::memory_order_release);
+        return index;
+    }
+
+    void add_reference(NodeIndex index) { slot(index).references.fetch_add(1, std::memory_order_relaxed); }
+
+    // Returns whether that was the last reference
+    [[nodiscard]] bool remove_reference(NodeIndex index) {
+        return slot(index).references.fetch_sub(1, std::memory_order_acq_rel) == 1;
+    }
+
+    void destroy(NodeIndex index) {
+        std::destroy_at(&(*this)[index]);
+
+        std::lock_guard lock(mutex);
+        slot(index).next_free = free_list;
+        free_list = index;
+        ++free;
+        --live;
+    }
+
+    WeakNodeIndex weak(NodeIndex index) const { return {index, slot(index).generation.load(std::memory_order_relaxed)}; }
+
+    bool alive(WeakNodeIndex weak) const {
+        if (weak.index >= next.load(std::memory_order_acquire)) return false;
+
+        const Slot &s = slot(weak.index);
+        return s.generation.load(std::memory_order_relaxed) == weak.generation && s.references.load(std::memory_order_acquire);
+    }
+
+    // Adds a reference and returns the index if the node is still alive, NULL_NODE otherwise
+    NodeIndex lock(WeakNodeIndex weak) {
+        if (!alive(weak)) return NULL_NODE;
+
+        add_reference(weak.index);
+        return weak.index;
+    }
+
+    // Invalidates every index and weak index handed out so far
+    void reset() {
+        destroy_all();
+
+        next.store(0, std::memory_order_relaxed);
+        free_list = NULL_NODE;
+        free = 0;
+        live = 0;
+    }
+
+    // Nodes that can still be created before the memory cap is reached
+    std::size_t remaining_nodes() const { return max_chunks * CHUNK_SLOTS - live; }
+
+    std::size_t live_nodes() const { return live; }
+
+    NodeArenaStatistics statistics() const { return {live, peak, free, failed, allocated_chunks * CHUNK_BYTES}; }
+
+private:
+    Slot &slot(NodeIndex index) { return chunks[index / CHUNK_SLOTS][index % CHUNK_SLOTS]; }
+
+    const Slot &slot(NodeIndex index) const { return chunks[index / CHUNK_SLOTS][index % CHUNK_SLOTS]; }
+
+    // Chunks are only ever added, so a published index always finds its chunk
+    bool allocate_chunk() {
+        if (allocated_chunks == max_chunks) return false;
+
+        void *memory = std::aligned_alloc(huge_pages ? HUGE_PAGE_BYTES : PAGE_BYTES, CHUNK_BYTES);
+        if (!memory) return false;
+#ifdef MADV_HUGEPAGE
+        if (huge_pages) madvise(memory, CHUNK_BYTES, MADV_HUGEPAGE);
+#endif
+
+        auto chunk = static_cast<Slot *>(memory);
+        for (std::size_t i = 0; i < CHUNK_SLOTS; ++i) ::new (&chunk[i]) Slot;
+        chunks[allocated_chunks++] = chunk;
+        return true;
+    }
+
+    void destroy_all() {
+        if constexpr (!std::is_trivially_destructible_v<T>) {
+            const NodeIndex end = next.load(std::memory_order_relaxed);
+            for (NodeIndex i = 0; i < end; ++i) {
+                if (slot(i).references.load(std::memory_order_relaxed)) std::destroy_at(&(*this)[i]);
+            }
+        }
+    }
+
+    const std::size_t max_chunks;
+    std::unique_ptr<Slot *[]> chunks;
+    std::size_t allocated_chunks = 0;
+    const bool huge_pages;
+
+    std::atomic<NodeIndex> next = 0;
+    NodeIndex free_list = NULL_NODE;
+    std::uint32_t generation_counter = 0;
+
+    std::size_t live = 0;
+    std::size_t peak = 0;
+    std::size_t free = 0;
+    std::size_t failed = 0;
+
+    SpinLock mutex;
+};
+
+}// namespace entropy
@@ -0,0 +1,109 @@
+#pragma once
+
+#include "board.hpp"
+#include "opening_book_data.hpp"
+
+#include <algorithm>
+
+namespace entropy {
+
+// Chips on the board up to which the book has moves: the first two placements of chaos and the first two replies of
+// order. Written by source/tools/generate_opening_book.cpp into opening_book_data.hpp, which is plain constant data,
+// so the book is part of the merged source file like any other header.
+constexpr inline uint OPENING_BOOK_CHIPS = 2;
+
+// The 8 symmetries of the board map a position and its best move onto each other, and so does renaming the colours
+// while every colour still started with the same number of chips. The book only holds the canonical position of each
+// class: the image with the smallest key, colours renamed 1, 2, ... in order of appearance.
+constexpr inline uint BOARD_SYMMETRIES = 8;
+
+inline Position transform(Position pos, uint symmetry) {
+    uint row = pos.row(), column = pos.column();
+    if (symmetry & 1) std::swap(row, column);
+    if (symmetry & 2) row = BOARD_SIZE - 1 - row;
+    if (symmetry & 4) column = BOARD_SIZE - 1 - column;
+    return {row, column};
+}
+
+inline Position inverse_transform(Position pos, uint symmetry) {
+    uint row = pos.row(), column = pos.column();
+    if (symmetry & 4) column = BOARD_SIZE - 1 - column;
+    if (symmetry & 2) row = BOARD_SIZE - 1 - row;
+    if (symmetry & 1) std::swap(row, column);
+    return {row, column};
+}
+
+// Book key of a position, `colour` is the colour that chaos has to place or 0 when order is to move
+inline std::uint64_t opening_book_key(const BoardHash &hash, uint colour) {
+    return hash.get_value() ^ colour * 0x9e3779b97f4a7c15ull;
+}
+
+// Key of the canonical image of the position and the symmetry that maps the position onto it
+inline std::uint64_t canonical_book_key(const BoardState &board, uint colour, uint &symmetry) {
+    std::uint64_t best = ~std::uint64_t(0);
+    symmetry = 0;
+    for (uint s = 0; s < BOARD_SYMMETRIES; ++s) {
+        std::array<Colour, BOARD_AREA> chips{};
+        for (uint i = 0; i < BOARD_AREA; ++i) {
+            const Position pos(i);
+            chips[transform(pos, s).index()] = board.get_minimal_state().read_chip(pos.row(), pos.column());
+        }
+
+        std::array<Colour, BOARD_COLOURS> names{};
+        Colour next_name = 1;
+        const auto rename = [&names, &next_name](Colour c) { return names[c] ? names[c] : names[c] = next_name++; };
+
+        BoardState image;
+        for (uint i = 0; i < BOARD_AREA; ++i)
+            if (chips[i]) image.place_chip({Position(i), rename(chips[i])});
+
+        const std::uint64_t key = opening_book_key(image.get_hash(), colour ? rename(colour) : 0);
+        if (key < best) best = key, symmetry = s;
+    }
+    return best;
+}
+
+// Chaos moves are stored as the cell, order moves as OrderMove::Compact with `from` in the high byte
+inline std::uint16_t encode_book_move(Position pos) { return std::uint16_t(pos.index()); }
+
+inline std::uint16_t encode_book_move(OrderMove::Compact move) { return std::uint16_t(move.from << 8 | move.to); }
+
+inline bool find_book_move(const BoardState &board, uint colour, std::uint16_t &move, uint &symmetry) {
+    if (BOARD_AREA - board.get_open_cells() > OPENING_BOOK_CHIPS) return false;
+
+    const std::uint64_t key = canonical_book_key(board, colour, symmetry);
+    const auto it = std::lower_bound(OPENING_BOOK_KEYS.begin(), OPENING_BOOK_KEYS.end(), key);
+    if (it == OPENING_BOOK_KEYS.end() || *it != key) return false;
+
+    move = OPENING_BOOK_MOVES[it - OPENING_BOOK_KEYS.begin()];
+    return true;
+}
+
+// A hash collision with a position outside of the book must not produce an illegal move, so book moves are checked
+inline bool find_book_chaos_move(const BoardState &board, Colour colour, Position &pos) {
+    std::uint16_t move;
+    uint symmetry;
+    if (!find_book_move(board, colour, move, symmetry) || move >= BOARD_AREA) return false;
+
+    pos = inverse_transform(Position(move), symmetry);
+    return !board.get_minimal_state().read_chip(pos.row(), pos.column());
+}
+
+inline bool find_book_order_move(const BoardState &board, OrderMove &move) {
+    std::uint16_t encoded;
+    uint symmetry;
+    if (!find_book_move(board, 0, encoded, symmetry)) return false;
+
+    const OrderMove::Compact compact(encoded >> 8, encoded & 0xff);
+    if (compact.is_pass()) return move = OrderMove{}, true;
+    if (compact.from >= BOARD_AREA || compact.to >= BOARD_AREA) return false;
+
+    move = OrderMove{inverse_transform(Position(compact.from), symmetry), inverse_transform(Position(compact.to), symmetry)};
+    bool legal = false;
+    board.get_minimal_state().for_each_possible_order_move([&legal, &move](auto from, auto to) {
+        legal |= from.p == move.from.p && to.p == move.to.p;
+    });
+    return legal;
+}
+
+}// namespace entropy
@@ -0,0 +1,413 @@
+// Generated by source/tools/generate_opening_book.cpp with 500000 rollouts per position, do not edit
+#pragma once
+
+#include <array>
+#include <cstdint>
+
+namespace entropy {
+
+// Sorted canonical_book_key() of every book position and its encoded move, see opening_book.hpp
+inline constexpr std::array<std::uint64_t, 373> OPENING_BOOK_KEYS{{
+0x0004c49d597ca626,
+0x001d6bce40707419,
+0x0021a470cd27b58a,
+0x00291d0c3fac7d11,
+0x0068efe77e543f64,
+0x008485d18cb47863,
+0x008d05dedfb62b1b,
+0x00ec6a36f2e04707,
+0x010b76187514812e,
+0x01297d0ce3716bb7,
+0x012ada670b56aa10,
+0x01646fad52d19931,
+0x0179c4c1e35d7982,
+0x018e8417c34b3397,
+0x01a5cca6df8883d3,
+0x01b3990e0230a621,
+0x01c3a060d64ff17d,
+0x01c71ceb3475065a,
+0x022b317af02aeae9,
+0x02615c5a5a36cb66,
+0x026e6941c7bc13f1,
+0x02741658fd655ff5,
+0x0298e5747fb1411a,
+0x029b4740e0cd19bb,
+0x02a15b39ce549fb0,
+0x02afa0f27f992cdd,
+0x02e36c9f180a38ea,
+0x0304979f11dc1c63,
+0x030805086ff37659,
+0x035a555725e779fd,
+0x0368bc194bec2a87,
+0x0368bde1052f2d75,
+0x036c788412908ca1,
+0x036de888db410b7d,
+0x0377dc55af8061d0,
+0x03818f303222f42f,
+0x0415feec26fed739,
+0x042794889e207bfd,
+0x049a5c2bc15e3b31,
+0x049fdaa034e9126b,
+0x04d380471272302e,
+0x04eb7e140245c9ea,
+0x04ee861cde5e458e,
+0x051884b5e7a7fd24,
+0x05321d6311e2cfa4,
+0x0586f409761fd267,
+0x059b7afbe5b5e4ae,
+0x05b0864cca089121,
+0x05bf0ea9c89f79f4,
+0x05c273ee126bca73,
+0x068fda4684688ee8,
+0x06bb9936d9436597,
+0x071e559006cbe644,
+0x073fb916d08a77ba,
+0x07781664fdbfdc44,
+0x077dc1dfbbc70200,
+0x0783c3f5076ae49f,
+0x07ca92365a9e4c70,
+0x07e38f3a65323161,
+0x08130944bf63b690,
+0x0842c41e097f5d31,
+0x084e4463c9fae796,
+0x085fafd0490f2928,
+0x0883962d3c559fd6,
+0x0886921b6aa197c5,
+0x08ceb2616d3c91e9,
+0x0936e19cda66c2b8,
+0x093825d40e5df2d2,
+0x0945327bbcee66b8,
+0x0945d97fe74b621f,
+0x095345ffa070a421,
+0x09681e790229f721,
+0x096d2d7756d23ba1,
+0x09a2582f599da94f,
+0x09c3d2918787d17f,
+0x09c7160cdefb7759,
+0x09de40217fc68f3a,
+0x09ee2854fb703612,
+0x0a650dd2ef4f1807,
+0x0a671f1c4206e965,
+0x0aafaa1595175dde,
+0x0ab1a33771183305,
+0x0ab3a8a9a4878447,
+0x0b08681d0ab2c485,
+0x0b319994a120b448,
+0x0b5ea0ec2960f20b,
+0x0b68b6fea1625b84,
+0x0b7a10d54a69678c,
+0x0bc867f692454a87,
+0x0be9c3865f62ff0d,
+0x0bf66a37b61f221a,
+0x0c012395abe2034a,
+0x0c0a3a01a85b5692,
+0x0c14b002fb497517,
+0x0c75a9c2b175c685,
+0x0c8babe80dd8201a,
+0x0c94669695c49125,
+0x0cd63266948eacc3,
+0x0cdea38402fe86b1,
+0x0ce8c55ac66e678d,
+0x0cf7961659a91949,
+0x0cfd8f58613df31e,
+0x0d7c7589102454f1,
+0x0da4d021f5bf693b,
+0x0daff6a777d3d541,
+0x0dd17aaaad087ce3,
+0x0def299c8307b809,
+0x0df24252c377cc10,
+0x0e09588a0aecb502,
+0x0e10eca8ed1539a1,
+0x0e14d2172558c34a,
+0x0e56cd2f97fd86f9,
+0x0e8999009c58aceb,
+0x0eeb4c3b3742f9d4,
+0x0efce4dc3c76b5eb,
+0x0f2ffc959492bf78,
+0x0f31bedb7f4d6ca5,
+0x0f7619266b8bed66,
+0x0f8746975f3fcf4d,
+0x0f9119d6b977767d,
+0x10200fca93537487,
+0x1048ba7e38656003,
+0x1086d0476d62e490,
+0x10d7a63aab5905cd,
+0x10ecafad9afcfa92,
+0x113207f1b766626e,
+0x11b096f1bb247bd6,
+0x11f1fda00114bb09,
+0x121a6133e738c2f4,
+0x122f7c471f549842,
+0x124a9608f7e3f7fb,
+0x125a3f7bb0131d3b,
+0x12638b04c84f8aea,
+0x129c1528da55b074,
+0x12a6fc3e0503b0fc,
+0x13078f7e07cb3ec0,
+0x1336d53584b2259d,
+0x141c3828a058dc30,
+0x142a834450c19f4a,
+0x143c7daee546fc72,
+0x146bd4ded608a945,
+0x149d5e4fa5965ae4,
+0x14c559780e10890c,
+0x154573046031819d,
+0x156a5ba4ece328f5,
+0x158c4c8808ca1770,
+0x15ade8f8c5eda2fa,
+0x15e4034c27ea6c30,
+0x164f97483ba2deb9,
+0x16817b7771d4eca7,
+0x1693dd5c9adfd0af,
+0x16a405225426426a,
+0x16b1c404b00c86f1,
+0x16b3bd46da0cc0c9,
+0x16bf769ccc2e959c,
+0x16cb3c5adc660429,
+0x16e98d7b21b38c1a,
+0x16fcfc000d26a86c,
+0x174c8f87bde1fd11,
+0x1754c1b7aeaad6f5,
+0x175a147523832a3b,
+0x1766cf481e5840c2,
+0x176f4341c7d4b526,
+0x17898c39204df771,
+0x17ac891e45ec1eac,
+0x17e2508b1ea90376,
+0x182cebb527e148a1,
+0x183eb4fd02a490ab,
+0x18d9bb44084e2015,
+0x18f5a48a07ca1d6e,
+0x18ffb24843cc3860,
+0x19247e0de0827f0d,
+0x199f72bb25d1ee80,
+0x19d47aaf9876ef73,
+0x1a3a6fecbdd4a6eb,
+0x1a4cc078924825e7,
+0x1ac09972d9304999,
+0x1b0f4f7710a895e4,
+0x1b6f1484a56141cc,
+0x1bd7134ad04965e3,
+0x1be32541e248d2e3,
+0x1bfb25d752102403,
+0x1c0b930d41cbfc7b,
+0x1ca1da33c0a10e2f,
+0x1caad2956b8e67e3,
+0x1cf3dcc261a331c3,
+0x1cf63dac07ddd844,
+0x1d3fc6029b1532de,
+0x1dfaa5ce7d46b061,
+0x1dfd4bf77f804180,
+0x1e10b05d79a90929,
+0x1e48c5f2634c53ec,
+0x1e94358cf51d714a,
+0x1ec16b84a254ebfa,
+0x1ff6dbadc4b605da,
+0x20219b91f92840a1,
+0x203e17ccf9eb50ba,
+0x205dc28b40dc755d,
+0x207b29084727a634,
+0x208bcf0bb5f1b19d,
+0x20e5990d4ad46f15,
+0x21ee78cee951e8e0,
+0x21f1f8e2e829c764,
+0x222ad80c641ba5dd,
+0x22374f376ba63823,
+0x2278f0475d56cef2,
+0x227d7c7935652e0f,
+0x234448fcba7e852a,
+0x243980f68d1df699,
+0x244ef64b20b6be90,
+0x24c78b09bd1461b5,
+0x24d98cfa8e85eee1,
+0x2572ae70b90e4895,
+0x25ba1a46c3bee25f,
+0x25bae16a1c9da40f,
+0x25c2381f909b599a,
+0x25dac61348f4f9e8,
+0x25e39c6f5dbcec10,
+0x25f181c9db4516aa,
+0x25fddd0131387453,
+0x26667c063cd5e500,
+0x2687be234bfe25b2,
+0x27598df504979ce5,
+0x275e62f3406dbe7b,
+0x2788727a16e5c53c,
+0x27b1bb3e1db9ea44,
+0x289062af16bac300,
+0x2908f650238d9202,
+0x29a0ab76f63a09ad,
+0x29c31b8a3b795ad0,
+0x29e2bffaf65eef5a,
+0x2a33381afc9fc999,
+0x2a42725c66b22103,
+0x2a870913a9df9ff7,
+0x2ab842974397f3ae,
+0x2ac881a1e3a02273,
+0x2b4605b620eb11e4,
+0x2b60b720d08ba2b1,
+0x2b827f7eb132b554,
+0x2c01bc8bb65851cb,
+0x2c7a1551472a03b0,
+0x2c967f67b5ca44b7,
+0x2cae98fe9148d072,
+0x2d65d326e489c8fa,
+0x2dbd09ba735f05ea,
+0x2df78bfbb000148a,
+0x2e1b5088fc83d8c3,
+0x2e87cdd47b5113df,
+0x2e8f665104ffd7bb,
+0x2edd7f4dc55ef54a,
+0x2f92e804d90ef772,
+0x2f962c9980725154,
+0x2ffa07e3a75ac816,
+0x2ffe94660444d141,
+0x306fd0e75576fb60,
+0x30d041e22f5dcaaa,
+0x30fa95e46b50690f,
+0x31748e7a1bc36d50,
+0x31825859a0a7fe5b,
+0x31eff03f1c981271,
+0x3256a31de52be28d,
+0x32764f0d0d18e744,
+0x32836838c33ee36a,
+0x32a7b82145094737,
+0x32af230e6929d3df,
+0x32b248c02959a7c6,
+0x32e7f537736b6428,
+0x32ee20ddb23772fa,
+0x33009822e6a632a5,
+0x331aa54339b9dfe2,
+0x341922a245121af5,
+0x356a197cd96b5d93,
+0x35a70e3d09b15d7e,
+0x3695dc48b779dc3b,
+0x36b825013b75a703,
+0x375d1493874510d6,
+0x37c99dd481d979f8,
+0x37d31865f4d4028b,
+0x37f15e3c39a64428,
+0x38141088e18ec370,
+0x3831bc01a72d0be8,
+0x389d68204ee75d03,
+0x3949c684a21dd39c,
+0x39b7b24745b1f713,
+0x39cf0edfe46b1cb3,
+0x3a031c6efad18838,
+0x3a1e77a0baa1fc21,
+0x3a242e0c795cd8e1,
+0x3abf74e7c76b498b,
+0x3b13916659c58435,
+0x3b417e290d7ffd2d,
+0x3baa51376534ad26,
+0x3bc2bed01b609242,
+0x3befac4b1bd9fc64,
+0x3d583f40fb25decc,
+0x3d71224cc489a3dd,
+0x3d80df9bfdbb6ca7,
+0x3e4479d79e6c6f13,
+0x3f5c5776fb1ca1c1,
+0x3f5d615caa5e1fcf,
+0x3f87d9b748239e6e,
+0x3ff79fb284bcf211,
+0x40771f6be67b8b55,
+0x40b35f1c163f54fe,
+0x40e95b586780f0ca,
+0x4237fbfc1ea6136d,
+0x423a1751e69894d2,
+0x42e48b1be1cef36b,
+0x430cca28950577c3,
+0x442604c4d5f3b49f,
+0x448247183090b6fc,
+0x4583c8620a7b374c,
+0x476e07b709b7d921,
+0x4816218ea55427d9,
+0x482239cf45297610,
+0x483555e6c3fbec48,
+0x485dba01bdafd32c,
+0x490e2b588ac5200b,
+0x49b656a0a57a2fc8,
+0x49f8efde6f2bc661,
+0x4a22bc99ea82c315,
+0x4a49021c0462d02b,
+0x4a812e2b8ab06128,
+0x4ab6052a6979a8e2,
+0x4af20eaac13141a6,
+0x4c40671c4eb0eba1,
+0x4c5339afd8e7adbf,
+0x4d311478f9dd0c6f,
+0x4d5766dbfa457fb1,
+0x4e51421fa3fa807c,
+0x4eae71c7735c05f7,
+0x4ee3e3b41602cfca,
+0x4f9454b448561f4d,
+0x5006248a6a73c788,
+0x51464d6b14ca45cf,
+0x51bac2d233f65bc0,
+0x52d65bf3cec73690,
+0x53d670a721b33eab,
+0x55ab9a2c75003490,
+0x591469ac6e30e688,
+0x5cde4099e7a46b79,
+0x5d8e3587af6eddb9,
+0x5db2aad7d30553df,
+0x5faa2e7adee36261,
+0x5fdc81eef17fe16d,
+0x6590c4c38c777893,
+0x662e9d8f801d1bf8,
+0x667b68c2e27f77b9,
+0x6847ae424d53e8ac,
+0x699b5045508b9d43,
+0x6a1cab55136993af,
+0x6ac779952adb207f,
+0x6b587de480284002,
+0x6b68716c404c448b,
+0x7041e03f451a1af8,
+0x7147a41d80fb0afb,
+0x715cf9ebe65e6c74,
+0x72447238daabd82b,
+0x73e810b6fc659871,
+0x7627f16efaf62801,
+0x773c21e0fedd18f8,
+0x78693cd7dd535818,
+0x7ab397f86f32b924,
+0x7b7176715f9f27b9,
+0x7c4e4a5d0ea2d057,
+0x83f6919e143c72c0,
+0x89d10ae8bc5888ad,
+0x8c6e044174c7f159,
+0x962b16ec2a2c8df4,
+0x9e3779b97f4a7c15,
+0xa4af84383e7426d8,
+0xc5178d025eac7e51,
+0xe81088d785bc5414,
+}};
+
+inline constexpr std::array<std::uint16_t, 373> OPENING_BOOK_MOVES{{
+6661,5376,2091,5932,9767,9769,4397,10279,3085,4911,7168,4878,7939,8732,11266,4116,
+4612,9245,8220,10025,2348,10798,9259,7682,8453,6689,2311,8476,2348,5659,6677,10245,
+9217,2571,8960,7964,6169,5675,770,7970,3105,10275,8226,9507,8495,10531,6165,768,
+8495,4370,10030,7452,7425,2829,2573,256,3335,5890,3604,8226,5376,4628,3841,11050,
+9763,4878,2820,12080,3077,6165,4372,7210,9513,23,9474,6677,2567,5168,10025,8220,
+9251,7425,3626,262,4654,9988,9516,11824,7467,7439,7682,24,11523,4878,3334,7682,
+42,5168,6421,10019,2061,65280,1280,4140,11562,4372,768,5390,7210,9516,2567,2091,
+11820,6918,11818,5675,1070,7970,1834,6960,7939,5890,4366,2055,11568,5659,4628,8710,
+7714,1584,6446,6189,5913,2573,10281,9511,31,4372,5633,6661,42,2091,1327,10277,
+11562,7939,2091,6171,7970,9507,11780,9988,5653,2317,768,4654,4098,3085,2862,9217,
+1024,5376,42,2862,24,8482,24,3085,4366,3085,11266,8196,24,42,5647,1282,
+6703,6169,3860,3883,10245,8476,2091,6427,3860,9745,5126,1024,4372,1327,9763,10030,
+2317,2829,10281,6147,4372,4098,10502,4110,9217,4878,9988,24,5904,2061,4628,24,
+3119,9988,24,8210,4140,9759,2306,2057,5675,7964,4140,512,2091,1327,2563,4622,
+10752,10531,9002,2820,9217,24,24,5418,5126,7714,3334,10544,10531,9988,12330,7682,
+9257,10277,4397,4878,6946,1584,3079,11824,5909,6171,9731,9731,10245,9474,8960,9763,
+24,3105,2317,2061,8226,25,6147,11056,5659,3860,2091,9251,3119,6171,6147,9516,
+12076,3854,4640,5918,4372,12078,813,11009,10752,7210,2591,11312,9513,5418,3854,11568,
+10800,3085,5915,9731,10245,6446,6683,5913,3335,4355,9259,5675,4355,6432,2348,5653,
+3119,7202,6677,12330,3860,518,11564,512,9773,11568,2567,10245,9731,10002,2348,2091,
+24,31,3860,2820,4140,9474,5890,24,2059,9474,6675,5418,7724,9516,31,9516,
+10544,6147,10502,772,30,1584,6147,260,5675,5890,5633,556,2348,6,24,5932,
+262,8752,299,8226,7682,11818,9773,6189,12076,2091,6147,3079,5909,6918,7458,4884,
+10752,24,4622,11567,31,
+}};
+
+}// namespace entropy
@@ -6,6 +6,8 @@
 
 namespace entropy {
 
+constexpr inline double GAME_TIME_BUDGET_MS = 27'000;// the referee allows 30 seconds per game
+
 template <bool PRINT = false, typename CHAOS, typename ORDER>
 inline uint simulate_game(CHAOS &&chaos, ORDER &&order) {
     BoardState b;
@@ -0,0 +1,26 @@
+#pragma once
+
+#include "board.hpp"
+
+namespace entropy::mcts {
+
+enum class RolloutKernel : uint8_t {
+    SCALAR,
+    AVX2,  // 8 lanes
+    AVX512,// 16 lanes
+};
+
+// Widest kernel the running CPU supports, detected once
+RolloutKernel rollout_batch_kernel();
+
+const char *rollout_kernel_name(RolloutKernel kernel);
+
+// Plays `n` independent smart rollouts from the same position and returns the sum of their final scores.
+// The playouts advance in lockstep, one per SIMD lane, and follow the same policy as smart_rollout_order and
+// smart_rollout_chaos, including the uniformly random choice between equally scored moves.
+// `chaos_first` is set when the position is a chaos node, i.e. chaos places the next chip.
+uint rollout_batch(const BoardState &board, const ChipPool &pool, uint n, bool chaos_first);
+
+uint rollout_batch(const BoardState &board, const ChipPool &pool, uint n, bool chaos_first, RolloutKernel kernel);
+
+}// namespace entropy::mcts
@@ -0,0 +1,144 @@
+#pragma once
+
+#include "board.hpp"
+#include "random.hpp"
+
+#include <array>
+
+namespace entropy {
+
+// Board for the greedy rollouts that keeps the scores of its rows and columns between plies. A chip that is placed or
+// moved only changes the lines it leaves and enters, so a ply looks up two to four line scores instead of all fourteen,
+// and scoring a move only looks up the lines with the chip placed or moved.
+class RolloutBoard {
+public:
+    explicit RolloutBoard(const MinimalBoardState &board) {
+        for (uint i = 0; i < BOARD_SIZE; ++i) {
+            horizontal[i] = board.get_horizontal_string(i);
+            vertical[i] = board.get_vertical_string(i);
+            h_scores[i] = lookup_score(horizontal[i]);
+            v_scores[i] = lookup_score(vertical[i]);
+        }
+    }
+
+    void place_chip(uint row, uint column, Colour c) {
+        horizontal[row].set_at_empty(column, c);
+        vertical[column].set_at_empty(row, c);
+        h_scores[row] = lookup_score(horizontal[row]);
+        v_scores[column] = lookup_score(vertical[column]);
+    }
+
+    void move_chip(Position from, Position to) {
+        const uint f_row = from.row(), f_column = from.column();
+        const uint t_row = to.row(), t_column = to.column();
+        const Colour c = Colour(horizontal[f_row].read(f_column));
+
+        remove_chip(f_row, f_column);
+        place_chip(t_row, t_column, c);
+        // The chip stays in one of the lines, which place_chip has scored already
+        if (f_row != t_row) h_scores[f_row] = lookup_score(horizontal[f_row]);
+        else v_scores[f_column] = lookup_score(vertical[f_column]);
+    }
+
+    // Same moves and scores as MinimalBoardState::for_each_possible_chaos_move_with_score
+    template <typename Function>
+    void for_each_possible_chaos_move_with_score(Colour c, Function &&f) const {
+        Position p{0};
+        for (uint row = 0; row < BOARD_SIZE; ++row) {
+            auto str = horizontal[row];
+            for (uint column = 0; column < BOARD_SIZE; ++column, ++p.p) {
+                if (!str.read_first()) {
+                    std::forward<Function>(f)(p, uint(lookup_score(horizontal[row].set_at_empty_copy(column, c)) - h_scores[row] +
+                                                      lookup_score(vertical[column].set_at_empty_copy(row, c)) - v_scores[column]));
+                }
+                str.shift_right_once();
+            }
+        }
+    }
+
+    const std::array<BoardString, BOARD_SIZE> &get_horizontal_strings() const { return horizontal; }
+
+    const std::array<BoardString, BOARD_SIZE> &get_vertical_strings() const { return vertical; }
+
+    // Same moves and scores as MinimalBoardState::for_each_possible_order_move_with_score
+    template <typename Function>
+    void for_each_possible_order_move_with_score(Function &&f) const {
+        for_each_slide_with_score<false>(horizontal, vertical, h_scores, v_scores, std::forward<Function>(f));
+        for_each_slide_with_score<true>(vertical, horizontal, v_scores, h_scores, std::forward<Function>(f));
+    }
+
+private:
+    void remove_chip(uint row, uint column) {
+        horizontal[row].set_null(column);
+        vertical[column].set_null(row);
+    }
+
+    std::array<BoardString, BOARD_SIZE> horizontal{};
+    std::array<BoardString, BOARD_SIZE> vertical{};
+    std::array<int, BOARD_SIZE> h_scores{};
+    std::array<int, BOARD_SIZE> v_scores{};
+};
+
+// The greedy rollout policy: order plays a move with the largest score gain, chaos places the drawn chip where it gains
+// the least, ties are broken uniformly at random. `s` accumulates the score of the board, the move is returned.
+template <typename RandomGenerator>
+inline OrderMove::Compact do_smart_order_move(RolloutBoard &board,
+                                              uint &s,
+                                              RandomGenerator &gen) {
+    OrderMove::Compact moves_buf[MAX_POSSIBLE_ORDER_MOVES];
+
+    moves_buf[0].make_pass();
+    uint n = 1;
+    int best_score = 0;
+    board.for_each_possible_order_move_with_score([&n, &moves_buf, &best_score](auto from, auto to, int score) {
+        if (score >= best_score) {
+            if (score > best_score) {
+                best_score = score;
+                n = 0;
+            }
+            moves_buf[n++] = {from, to};
+        }
+    });
+
+    auto it = random_element(moves_buf, n, gen);
+    if (!it->is_pass()) {
+        auto m = it->create();
+        board.move_chip(m.from, m.to);
+
+        s += best_score;
+    }
+    return *it;
+}
+
+// Draws the chip from the first `open_cells` entries of `chips`, which hold the pool
+template <typename RandomGenerator>
+inline ChaosMove do_smart_chaos_move(RolloutBoard &board,
+                                     uint &s,
+                                     uint open_cells,
+                                     std::array<uint8_t, BOARD_AREA> &chips,
+                                     RandomGenerator &gen) {
+    uint8_t moves_buf[BOARD_AREA];
+
+    auto rand_it = random_element(chips.begin(), open_cells, gen);
+    const Colour colour = *rand_it;
+    *rand_it = chips[open_cells - 1];
+
+    uint n = 0;
+    uint best_score = -1u;
+    board.for_each_possible_chaos_move_with_score(colour, [&n, &moves_buf, &best_score](auto p, uint score) {
+        if (score == best_score) moves_buf[n++] = p.p;
+        else if (score < best_score) {
+            moves_buf[0] = p.p;
+            best_score = score;
+            n = 1;
+        }
+    });
+
+    Position p = *random_element(moves_buf, n, gen);
+    board.place_chip(p.row(), p.column(), colour);
+
+    s += best_score;
+    return {p, colour};
+}
+
+}// namespace entropy
@@ -0,0 +1,73 @@
+#pragma once
+
+#include "board.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+
+namespace entropy {
+
+using Clock = std::chrono::steady_clock;
+
+constexpr inline uint CLOCK_CHECK_INTERVAL = 16;
+
+inline double millis_between(Clock::time_point begin, Clock::time_point end) {
+    return double(std::chrono::duration_cast<std::chrono::microseconds>(end - begin).count()) / 1000.;
+}
+
+// Relative search effort spent on a move with `open_cells` empty cells left.
+// The first moves have wide trees but decide little and the last moves are nearly forced,
+// so the midgame gets the largest share of the game budget.
+constexpr inline float move_weight(uint open_cells) {
+    return float(std::min({open_cells, BOARD_AREA + 10 - open_cells, 24u}));
+}
+
+// Splits a budget for the whole game into per-move deadlines.
+// Both players make one more move for every open cell, so the remaining budget is divided over
+// the weights of all future moves. Time that a move does not use is carried over to the next ones.
+class TimeManager {
+public:
+    TimeManager() = default;
+
+    explicit TimeManager(double game_budget_ms, double reserve_ms = 500) : budget(game_budget_ms), reserve(reserve_ms) {}
+
+    bool enabled() const { return budget > 0; }
+
+    double remaining_millis() const { return budget - used; }
+
+    Clock::time_point start_move(uint open_cells) {
+        move_begin = Clock::now();
+        if (!enabled() || !open_cells) return allocated = 0, Clock::time_point::max();
+
+        float total_weight = 0;
+        for (uint i = 1; i <= open_cells; ++i) total_weight += move_weight(i);
+
+        allocated = std::max(0., remaining_millis() - reserve) * move_weight(open_cells) / total_weight;
+        return move_begin + std::chrono::microseconds(std::int64_t(allocated * 1000));
+    }
+
+    void end_move() {
+        if (!enabled()) return;
+
+        const double move_time = millis_between(move_begin, Clock::now());
+        used += move_time;
+        carried_over += allocated - move_time;
+
+        std::cerr << "time: used " << move_time << "ms of " << allocated << "ms"
+                  << "; carried over " << carried_over << "ms"
+                  << "; game total " << used << "ms of " << budget << "ms\n";
+    }
+
+private:
+    double budget = 0;
+    double reserve = 0;
+
+    double used = 0;
+    double allocated = 0;
+    double carried_over = 0;
+
+    Clock::time_point move_begin{};
+};
+
+}// namespace entropy
@@ -0,0 +1,116 @@
+#pragma once
+
+#include "board.hpp"
+#include "node_arena.hpp"
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+
+namespace entropy {
+
+struct TranspositionStatistics {
+    std::uint64_t lookups = 0;
+    std::uint64_t hits = 0;
+    std::uint64_t collisions = 0;// inserts that evicted a live node
+    std::size_t occupied = 0;
+    std::size_t capacity = 0;
+
+    float hit_rate() const { return lookups ? float(hits) / float(lookups) : 0; }
+
+    float occupancy() const { return capacity ? float(occupied) / float(capacity) : 0; }
+};
+
+// Fixed size open addressing table from board hashes to nodes of a NodeArena, one cache line per bucket.
+// Entries only hold weak indices, so nodes released by the search or a reset of the arena simply stop matching.
+// When a bucket is full the live node with the fewest visits is replaced, the deeper one on ties.
+template <typename Node>
+class TranspositionTable {
+    struct Entry {
+        std::uint64_t hash;
+        NodeIndex index;
+        std::uint32_t generation;
+    };
+
+    constexpr static inline std::size_t BUCKET_ENTRIES = 3;
+
+    struct alignas(64) Bucket {
+        Entry entries[BUCKET_ENTRIES];
+        std::uint8_t open_spaces[BUCKET_ENTRIES];
+        SpinLock lock;
+    };
+
+    static_assert(sizeof(Bucket) == 64);
+
+public:
+    TranspositionTable(NodeArena<Node> &arena, std::size_t memory_budget) : arena(arena) {
+        std::size_t buckets = 1;
+        while (buckets * 2 * sizeof(Bucket) <= memory_budget) buckets *= 2;
+
+        mask = buckets - 1;
+        table.reset(new Bucket[buckets]{});
+    }
+
+    // Returns a new reference to the node stored for `hash`, or to the node returned by `create` after storing it.
+    // Nothing is stored when `create` fails with NULL_NODE.
+    template <typename Create>
+    NodeIndex find_or_create(const BoardHash &hash, Create &&create) {
+        const std::uint64_t value = hash.get_value();
+        const auto open_spaces = std::uint8_t(hash.get_open_spaces());
+        auto &bucket = table[value & mask];
+
+        std::lock_guard lock(bucket.lock);
+        lookups.fetch_add(1, std::memory_order_relaxed);
+
+        uint victim = 0;
+        std::uint64_t victim_priority = UINT64_MAX;
+        for (uint i = 0; i < BUCKET_ENTRIES; ++i) {
+            const Entry &entry = bucket.entries[i];
+            const WeakNodeIndex weak{entry.index, entry.generation};
+
+            if (entry.hash == value && bucket.open_spaces[i] == open_spaces) {
+                if (const NodeIndex index = arena.lock(weak); index != NULL_NODE) {
+                    hits.fetch_add(1, std::memory_order_relaxed);
+                    return index;
+                }
+                victim = i, victim_priority = 0;
+                break;
+            }
+
+            const std::uint64_t priority = arena.alive(weak) ? std::uint64_t(arena[entry.index].get_total_visits()) << 8 | bucket.open_spaces[i] : 0;
+            if (priority < victim_priority) victim = i, victim_priority = priority;
+        }
+
+        const NodeIndex index = std::forward<Create>(create)();
+        if (index == NULL_NODE) return index;
+
+        if (victim_priority) collisions.fetch_add(1, std::memory_order_relaxed);
+        bucket.entries[victim] = {value, index, arena.weak(index).generation};
+        bucket.open_spaces[victim] = open_spaces;
+        return index;
+    }
+
+    // Counts the occupied entries, must not run concurrently with a search
+    TranspositionStatistics statistics() const {
+        TranspositionStatistics result{lookups, hits, collisions, 0, (mask + 1) * BUCKET_ENTRIES};
+        for (std::size_t b = 0; b <= mask; ++b) {
+            for (const Entry &entry : table[b].entries) result.occupied += arena.alive({entry.index, entry.generation});
+        }
+        return result;
+    }
+
+    void reset_statistics() { lookups = hits = collisions = 0; }
+
+private:
+    NodeArena<Node> &arena;
+
+    std::unique_ptr<Bucket[]> table;
+    std::size_t mask;
+
+    std::atomic<std::uint64_t> lookups{};
+    std::atomic<std::uint64_t> hits{};
+    std::atomic<std::uint64_t> collisions{};
+};
+
+}// namespace entropy
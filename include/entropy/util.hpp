@@ -2,8 +2,11 @@
 
 #include <algorithm>
 #include <array>
+#include <atomic>
 #include <memory>
+#include <mutex>
 #include <random>
+#include <thread>
 
 namespace entropy {
 
@@ -57,68 +60,18 @@ constexpr std::array<T, N> create_array(const T &value) {
     return create_array(value, std::make_index_sequence<N>());
 }
 
-// Only use in global context, destructor may cause memory leaks
-template <typename T, std::size_t N>
-class PreallocatedBuffer {
-    using Storage = typename std::aligned_storage_t<sizeof(T), alignof(T)>;
-
+class SpinLock {
 public:
-    typedef T value_type;
-    typedef value_type *pointer;
-
-    constexpr static inline std::size_t max_capacity = N;
-
-    struct Deleter {
-        PreallocatedBuffer &buffer;
-
-        void operator()(pointer ptr) { buffer.deallocate(ptr); }
-    };
-
-    ~PreallocatedBuffer() {
-        std::sort(gaps, gaps + gap_amount);
-        std::size_t gap_index = 0;
-        for (auto it = buffer; it != next; ++it) {
-            if (gap_index < gap_amount && it == gaps[gap_index]) ++gap_index;
-            else std::destroy_at(std::launder(reinterpret_cast<pointer>(it)));
-        }
-    }
-
-    [[nodiscard]] pointer allocate() {
-        if (gap_amount) {
-            return std::launder(reinterpret_cast<pointer>(gaps[--gap_amount]));
-        } else {
-            return std::launder(reinterpret_cast<pointer>(next++));
+    void lock() {
+        while (locked.exchange(true, std::memory_order_acquire)) {
+            while (locked.load(std::memory_order_relaxed)) std::this_thread::yield();
         }
     }
 
-    void deallocate(pointer ptr) {
-        std::destroy_at(ptr);
-        gaps[gap_amount++] = std::launder(reinterpret_cast<Storage *>(ptr));
-    }
-
-    Deleter get_deleter() { return {*this}; }
-
-    template <typename... Args>
-    [[nodiscard]] pointer construct(Args &&...args) {
-        return ::new (allocate()) T(std::forward<Args>(args)...);
-    }
-
-    template <typename... Args>
-    std::unique_ptr<T, Deleter> make_unique(Args &&...args) {
-        return {construct(std::forward<Args>(args)...), get_deleter()};
-    }
-
-    template <typename... Args>
-    std::shared_ptr<T> make_shared(Args &&...args) {
-        return std::shared_ptr<T>(construct(std::forward<Args>(args)...), get_deleter());
-    }
+    void unlock() { locked.store(false, std::memory_order_release); }
 
 private:
-    Storage buffer[max_capacity];
-    Storage *gaps[max_capacity];
-
-    Storage *next = buffer;
-    std::size_t gap_amount = 0;
+    std::atomic<bool> locked = false;
 };
 
 }// namespace entropy
\ No newline at end of file
@@ -0,0 +1,170 @@
+#pragma once
+
+#include "board.hpp"
+#include "rollout_board.hpp"
+#include "value_function_weights.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <istream>
+#include <ostream>
+#include <string_view>
+
+namespace entropy {
+
+// N-tuple estimate of how much the score still grows until the end of a greedy rollout, from a position with order to
+// move. Every row and column is split into the windows of VALUE_TUPLE_CELLS consecutive cells, and the raw bits of a
+// window in the BoardString encoding index a table of pattern classes. A class holds the windows that are the same up
+// to renaming the colours and mirroring, which is what palindromes depend on, so every class has one weight per stage
+// of the game. The weights are trained offline by source/tools/train_value_function.cpp.
+constexpr inline uint VALUE_TUPLE_CELLS = 5;
+constexpr inline uint VALUE_TUPLE_BITS = 3 * VALUE_TUPLE_CELLS;
+constexpr inline uint VALUE_TUPLE_OFFSETS = BOARD_SIZE - VALUE_TUPLE_CELLS + 1;
+constexpr inline uint VALUE_OFFSET_CLASSES = (VALUE_TUPLE_OFFSETS + 1) / 2;// mirrored windows share their weights
+constexpr inline uint VALUE_TUPLES = 2 * BOARD_SIZE * VALUE_TUPLE_OFFSETS;
+constexpr inline uint VALUE_TUPLE_PATTERNS = 117;
+constexpr inline uint VALUE_STAGES = 8;
+
+static_assert(BOARD_COLOURS == 8, "the tuples read 3 bits per cell");
+
+// Per stage: the tuple weights of every offset class, then a bias and the weight of the same colour probability
+constexpr inline uint VALUE_STAGE_WEIGHTS = VALUE_OFFSET_CLASSES * VALUE_TUPLE_PATTERNS + 2;
+constexpr inline uint VALUE_BIAS_WEIGHT = VALUE_STAGE_WEIGHTS - 2;
+constexpr inline uint VALUE_SAME_COLOUR_WEIGHT = VALUE_STAGE_WEIGHTS - 1;
+constexpr inline uint VALUE_WEIGHTS = VALUE_STAGES * VALUE_STAGE_WEIGHTS;
+
+using ValueWeights = std::array<float, VALUE_WEIGHTS>;
+
+static_assert(VALUE_FUNCTION_WEIGHTS.size() == VALUE_WEIGHTS, "the generated weights are for another layout");
+
+struct TuplePatternTable {
+    std::array<std::uint16_t, 1 << VALUE_TUPLE_BITS> index{};
+    uint patterns = 0;
+};
+
+// Colours are renamed in the order they first appear in, and the smaller encoding of both directions is the class
+constexpr TuplePatternTable generate_tuple_pattern_table() {
+    TuplePatternTable result{};
+    std::array<std::uint16_t, 1 << VALUE_TUPLE_BITS> class_of_canonical{};// class + 1, 0 for unseen
+
+    const auto canonical = [](uint raw, bool mirrored) {
+        uint names[BOARD_COLOURS]{};
+        uint next_name = 0, encoded = 0;
+        for (uint i = 0; i < VALUE_TUPLE_CELLS; ++i) {
+            const uint cell = mirrored ? VALUE_TUPLE_CELLS - 1 - i : i;
+            const uint colour = raw >> 3 * cell & 7;
+            if (colour && !names[colour]) names[colour] = ++next_name;
+            encoded |= names[colour] << 3 * i;
+        }
+        return encoded;
+    };
+
+    for (uint raw = 0; raw < result.index.size(); ++raw) {
+        const uint forward = canonical(raw, false), backward = canonical(raw, true);
+        auto &c = class_of_canonical[forward < backward ? forward : backward];
+        if (!c) c = std::uint16_t(++result.patterns);
+        result.index[raw] = std::uint16_t(c - 1);
+    }
+    return result;
+}
+
+constexpr inline TuplePatternTable TUPLE_PATTERN_TABLE = generate_tuple_pattern_table();
+
+static_assert(TUPLE_PATTERN_TABLE.patterns == VALUE_TUPLE_PATTERNS);
+
+constexpr inline uint value_stage(uint open_cells) { return (open_cells - 1) * VALUE_STAGES / (BOARD_AREA - 1); }
+
+// Everything the estimate reads, the tuples as indices into the weights of the stage
+struct ValueFeatures {
+    std::array<std::uint16_t, VALUE_TUPLES> tuples;
+    uint stage;
+    float same_colour;// probability that the next two chips drawn have the same colour
+};
+
+// `chip_counts` holds the chips left in the pool per colour, `open_cells` their total
+inline ValueFeatures extract_value_features(const std::array<BoardString, BOARD_SIZE> &horizontal,
+                                            const std::array<BoardString, BOARD_SIZE> &vertical,
+                                            uint open_cells,
+                                            const std::array<uint, BOARD_COLOURS> &chip_counts) {
+    ValueFeatures result;
+    result.stage = value_stage(open_cells);
+
+    uint pairs = 0;
+    for (uint n : chip_counts) pairs += n ? n * (n - 1) : 0;
+    result.same_colour = open_cells > 1 ? float(pairs) / float(open_cells * (open_cells - 1)) : 0;
+
+    uint n = 0;
+    for (const auto *lines : {&horizontal, &vertical}) {
+        for (const BoardString line : *lines) {
+            for (uint offset = 0; offset < VALUE_TUPLE_OFFSETS; ++offset) {
+                const uint offset_class = offset < VALUE_TUPLE_OFFSETS - 1 - offset ? offset : VALUE_TUPLE_OFFSETS - 1 - offset;
+                const uint raw = line.hash >> 3 * offset & ((1 << VALUE_TUPLE_BITS) - 1);
+                result.tuples[n++] = std::uint16_t(offset_class * VALUE_TUPLE_PATTERNS + TUPLE_PATTERN_TABLE.index[raw]);
+            }
+        }
+    }
+    return result;
+}
+
+// A fixed number of independent loads and adds, without branches
+inline float estimate_value_gain(const ValueWeights &weights, const ValueFeatures &features) {
+    const float *stage = weights.data() + features.stage * VALUE_STAGE_WEIGHTS;
+
+    float sum = stage[VALUE_BIAS_WEIGHT] + stage[VALUE_SAME_COLOUR_WEIGHT] * features.same_colour;
+    for (uint i = 0; i < VALUE_TUPLES; ++i) sum += stage[features.tuples[i]];
+    return sum;
+}
+
+// Estimate of the score that a greedy rollout still adds, `chips` holds the pool in its first `open_cells` entries
+inline float estimate_value_gain(const RolloutBoard &board, uint open_cells, const std::array<uint8_t, BOARD_AREA> &chips) {
+    std::array<uint, BOARD_COLOURS> chip_counts{};
+    for (uint i = 0; i < open_cells; ++i) ++chip_counts[chips[i]];
+    return estimate_value_gain(VALUE_FUNCTION_WEIGHTS,
+                               extract_value_features(board.get_horizontal_strings(), board.get_vertical_strings(), open_cells, chip_counts));
+}
+
+// Estimate of the final score of a greedy rollout from a position with order to move
+inline float estimate_final_score(const BoardState &board, const ChipPool &pool) {
+    if (!board.get_open_cells()) return float(board.get_total_score());
+
+    std::array<BoardString, BOARD_SIZE> horizontal, vertical;
+    for (uint i = 0; i < BOARD_SIZE; ++i) {
+        horizontal[i] = board.get_minimal_state().get_horizontal_string(i);
+        vertical[i] = board.get_minimal_state().get_vertical_string(i);
+    }
+    std::array<uint, BOARD_COLOURS> chip_counts{};
+    for (Colour c = 1; c < BOARD_COLOURS; ++c) chip_counts[c] = pool.chips_left(c);
+
+    return float(board.get_total_score()) +
+           estimate_value_gain(VALUE_FUNCTION_WEIGHTS, extract_value_features(horizontal, vertical, board.get_open_cells(), chip_counts));
+}
+
+/*
+ * Weights file: the magic "ENTV", then the format version, VALUE_TUPLE_CELLS, VALUE_STAGES and VALUE_WEIGHTS as
+ * little endian uint32, then the weights as little endian floats in the order of ValueWeights.
+ */
+constexpr inline std::uint32_t VALUE_WEIGHTS_VERSION = 1;
+
+inline void save_value_weights(std::ostream &out, const ValueWeights &weights) {
+    const std::uint32_t header[] = {VALUE_WEIGHTS_VERSION, VALUE_TUPLE_CELLS, VALUE_STAGES, VALUE_WEIGHTS};
+    out.write("ENTV", 4);
+    out.write(reinterpret_cast<const char *>(header), sizeof(header));
+    out.write(reinterpret_cast<const char *>(weights.data()), sizeof(weights));
+}
+
+// Fails on another magic, version or layout
+inline bool load_value_weights(std::istream &in, ValueWeights &weights) {
+    char magic[4]{};
+    std::uint32_t header[4]{};
+    in.read(magic, 4);
+    in.read(reinterpret_cast<char *>(header), sizeof(header));
+
+    const std::uint32_t expected[] = {VALUE_WEIGHTS_VERSION, VALUE_TUPLE_CELLS, VALUE_STAGES, VALUE_WEIGHTS};
+    if (!in || std::string_view(magic, 4) != "ENTV" || !std::equal(header, header + 4, expected)) return false;
+
+    in.read(reinterpret_cast<char *>(weights.data()), sizeof(weights));
+    return bool(in);
+}
+
+}// namespace entropy
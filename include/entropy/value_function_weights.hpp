@@ -0,0 +1,169 @@
+// Generated by source/tools/train_value_function.cpp from 1000000 self-play games, do not edit
+#pragma once
+
+#include <array>
+
+namespace entropy {
+
+inline constexpr std::array<float, 1888> VALUE_FUNCTION_WEIGHTS{{
+0.0394376f,1.67244f,1.74916f,1.64119f,3.01980f,1.03592f,1.74241f,2.41335f,1.29201f,1.33681f,2.16815f,2.34719f,
+1.70190f,1.95692f,2.12383f,1.50080f,1.80930f,1.41774f,1.34771f,1.12761f,1.21723f,1.67626f,1.03338f,0.998868f,
+1.72455f,1.75814f,1.61716f,0.393928f,0.909667f,1.49041f,1.15458f,0.888158f,0.993573f,2.51808f,0.289559f,0.966007f,
+1.13092f,0.246440f,0.369529f,0.638810f,0.434433f,0.181528f,0.631620f,0.647671f,0.610550f,0.217588f,0.298064f,0.365489f,
+1.03572f,1.88923f,1.31658f,2.58127f,2.53585f,1.18421f,1.57308f,1.10116f,0.450222f,3.55570f,0.878422f,0.0929332f,
+-0.224355f,0.0157925f,2.20448f,1.33701f,1.89118f,1.44498f,1.91744f,4.00664f,-0.0753674f,0.940192f,0.955558f,0.241484f,
+0.427038f,0.703937f,-0.345145f,1.42279f,1.59830f,0.818068f,0.775957f,-0.189524f,-0.119930f,-0.305204f,-0.236436f,-0.0678940f,
+-0.294879f,-0.373443f,-0.0459365f,-0.164606f,0.0400711f,0.131470f,-0.0967096f,-0.00738054f,-0.0424277f,2.02552f,1.44140f,0.109924f,
+0.758989f,0.696976f,0.814541f,-0.373431f,0.164454f,-0.306709f,-0.00965448f,-0.297107f,-0.144712f,-0.0760812f,-0.0393982f,0.000299698f,
+0.101042f,0.215164f,0.176085f,0.189748f,0.184040f,-0.272026f,0.0386215f,0.250286f,0.0697105f,0.0303755f,0.926545f,0.960013f,
+0.873444f,1.81607f,0.477904f,1.29204f,1.57713f,0.757949f,1.24635f,1.52911f,1.49079f,1.33390f,0.981874f,1.14732f,
+0.726933f,0.539988f,1.89148f,1.00887f,1.51503f,0.526022f,-0.0715261f,0.531794f,0.238478f,0.503348f,1.34896f,2.17754f,
+1.19148f,1.64356f,1.11165f,0.719728f,0.513057f,0.813894f,1.27257f,-0.201544f,0.352621f,2.09831f,0.652002f,0.789075f,
+1.18505f,0.808220f,-0.154019f,0.251812f,0.385998f,0.152785f,0.00817302f,0.0249335f,0.174773f,0.339433f,0.582180f,0.593854f,
+0.757898f,1.12414f,0.230981f,-0.144637f,1.30249f,-0.00731665f,3.03475f,-0.250714f,0.0932273f,-0.730909f,-0.498273f,1.52931f,
+0.371413f,0.481346f,0.457301f,0.605557f,3.45239f,-0.424467f,0.0572301f,0.281263f,-0.0329193f,-0.168483f,0.0418231f,-0.681783f,
+1.13919f,0.464810f,0.504861f,0.137471f,-0.288174f,-0.223826f,-0.440438f,-0.551439f,-0.389404f,-0.312956f,-0.105595f,0.0225039f,
+-0.138561f,-0.250004f,-0.102748f,-0.385615f,-0.314978f,-0.178844f,-0.465223f,-0.402466f,0.0737813f,0.690563f,-0.161693f,0.0174879f,
+-0.166453f,-0.156345f,-0.0553100f,0.000871285f,-0.225417f,-0.237305f,-0.194408f,-0.186518f,-0.113458f,0.202466f,-0.0181686f,-0.154392f,
+-0.0622403f,-0.0530523f,0.0212063f,0.162606f,-0.0415802f,-0.109796f,3.60840f,0.971213f,4.00457f,3.04096f,2.74219f,2.42381f,
+2.96031f,3.37216f,1.47594f,2.56503f,2.79426f,0.836006f,2.23902f,2.37846f,1.22328f,1.57888f,2.10195f,2.98869f,
+1.78995f,1.69449f,1.60378f,1.32320f,1.43823f,1.81282f,0.924325f,1.19599f,2.38900f,2.14678f,1.97600f,0.405746f,
+1.06670f,1.83022f,1.08070f,0.709021f,1.28056f,2.60055f,0.403299f,1.21662f,1.32141f,0.00970913f,0.149373f,0.847955f,
+0.365359f,-0.111971f,1.10862f,0.956434f,1.02681f,0.147978f,0.255074f,0.687219f,3.19192f,1.83828f,3.89122f,2.72606f,
+2.67817f,1.16317f,1.71149f,0.694933f,0.415390f,4.43968f,1.16300f,-0.267093f,-0.647638f,-0.0740658f,2.46883f,1.57697f,
+2.28227f,1.47756f,2.04507f,4.21830f,-0.246234f,1.34499f,1.48131f,0.141670f,0.458530f,0.961387f,-1.20267f,1.20104f,
+1.78323f,0.382872f,0.714530f,-1.03330f,-0.479657f,-1.01759f,-0.981769f,-0.465894f,-0.891642f,-1.01576f,-0.366054f,-0.769278f,
+0.191397f,0.128449f,-0.555995f,-0.227495f,-0.0366741f,2.33779f,1.51488f,-0.266107f,0.709670f,0.786053f,0.807813f,-1.06597f,
+0.210267f,-1.01530f,-0.243876f,-0.759596f,-0.317570f,-0.209817f,-0.507158f,-0.360725f,0.104778f,0.738128f,0.573215f,0.648492f,
+0.541997f,-0.628655f,0.216321f,0.601298f,0.466084f,2.61663f,1.81061f,1.70583f,1.75358f,1.57240f,2.14850f,0.900207f,
+1.57937f,1.95307f,0.611657f,1.38074f,1.26500f,0.909433f,0.422098f,0.988895f,1.06090f,0.257371f,2.65262f,1.65396f,
+1.85309f,0.268285f,-0.143134f,0.274361f,0.0651458f,0.996418f,1.42783f,3.57534f,1.57061f,2.18442f,0.979980f,0.679592f,
+0.434930f,0.764893f,1.25495f,-0.471486f,0.463591f,2.54072f,0.985993f,1.01612f,1.73639f,0.831939f,-0.625254f,0.170995f,
+0.269982f,0.00653852f,-0.152315f,-0.189813f,0.165288f,1.55924f,0.377749f,2.11025f,0.467816f,1.09234f,0.104359f,-0.0100575f,
+1.05443f,-0.393939f,4.69763f,-0.393294f,-0.326005f,-1.26268f,-0.792324f,1.58009f,0.595302f,0.594068f,0.513106f,0.677407f,
+3.58649f,-0.863441f,0.138372f,0.533677f,-0.0904138f,-0.285859f,0.212585f,-1.81098f,1.03229f,0.475011f,-0.236972f,-0.125530f,
+-0.384193f,-0.224525f,-0.764753f,-1.14393f,-0.810074f,-0.624306f,-0.132714f,0.363748f,-0.0408152f,-0.413241f,-0.177830f,-0.808420f,
+-0.847719f,-0.391509f,-0.340393f,-0.682152f,0.118308f,1.14587f,-0.0862188f,-0.143834f,-0.179277f,-0.184896f,-0.0527678f,0.288842f,
+-0.612326f,-0.581847f,-0.472828f,-0.452580f,-0.00448853f,0.758798f,0.286412f,-0.0413360f,0.124968f,0.0411773f,0.108666f,0.647252f,
+-0.128106f,-0.269836f,4.13376f,3.04845f,3.68690f,2.79863f,2.62023f,1.98013f,2.80565f,3.32232f,1.24527f,2.55090f,
+2.49778f,0.650409f,2.30221f,2.33478f,0.890612f,1.27147f,2.12996f,3.12781f,1.95652f,1.86687f,1.29050f,1.30745f,
+1.67343f,1.83774f,0.844887f,1.21988f,2.54750f,2.38791f,2.09567f,0.412071f,1.21528f,2.28649f,1.10374f,0.662577f,
+1.66176f,2.80989f,0.542431f,1.54628f,1.44811f,0.0862992f,0.147593f,1.00161f,-0.0981736f,-0.573000f,1.16933f,1.23608f,
+1.14230f,0.240394f,0.232419f,1.02652f,3.36920f,2.08924f,4.79812f,2.74219f,2.78271f,0.943738f,1.90009f,0.551648f,
+0.352912f,4.53866f,1.06633f,-0.462724f,-0.797866f,-0.170019f,2.78680f,1.95878f,2.25431f,1.53253f,2.34042f,4.42538f,
+-0.447647f,1.69003f,1.87672f,0.0583658f,0.709935f,1.41751f,-1.53939f,0.813688f,1.87211f,-0.0434046f,0.784796f,-2.05239f,
+-0.673761f,-1.55239f,-1.76875f,-0.603645f,-1.59787f,-1.67549f,-0.666374f,-1.46695f,-0.0862835f,0.156531f,-0.862755f,-0.547911f,
+-0.0351191f,2.54504f,1.57648f,-0.529947f,0.852581f,1.20861f,1.05077f,-1.58101f,0.170697f,-1.47996f,-0.432150f,-1.00174f,
+-0.564289f,-0.337457f,-0.700904f,-0.692337f,0.350782f,1.13776f,1.05801f,1.20068f,1.13615f,-0.708225f,0.460501f,0.953785f,
+0.882045f,2.84719f,1.89224f,1.50644f,1.40026f,1.45091f,2.11870f,0.681658f,1.37320f,1.96579f,0.258368f,1.07989f,
+1.22145f,0.668547f,0.207776f,0.859159f,1.23912f,0.313887f,3.08044f,1.91204f,2.02923f,0.0495623f,-0.215648f,-0.0421295f,
+-0.234386f,1.24779f,1.42970f,4.04484f,1.94176f,2.70137f,1.09008f,0.751699f,0.163492f,0.960768f,1.29140f,-0.543068f,
+0.601737f,2.91739f,1.15090f,1.26075f,2.15520f,0.774620f,-0.959713f,0.343077f,0.266564f,-0.0147259f,-0.484459f,-0.431550f,
+-0.0549512f,1.98668f,0.580651f,2.77156f,0.578787f,1.28832f,-0.283625f,0.168586f,0.696230f,-0.434082f,5.37806f,-0.366058f,
+-0.476381f,-1.78380f,-1.03493f,1.98929f,0.653433f,0.818819f,0.564918f,0.894341f,3.30240f,-1.14172f,0.271081f,0.831582f,
+-0.398857f,-0.410999f,0.291245f,-1.89117f,1.23575f,0.272831f,-0.821045f,-0.525985f,-0.527648f,-0.105413f,-0.973183f,-1.61164f,
+-1.07602f,-0.951164f,0.0765806f,0.711594f,-0.206759f,-0.768145f,-0.334895f,-1.14567f,-1.21985f,-0.870729f,-0.0807950f,-0.712542f,
+0.208534f,1.35144f,-0.252281f,-0.280669f,-0.131798f,-0.260746f,0.00572076f,0.476612f,-0.844002f,-0.905856f,-0.761643f,-0.292828f,
+0.0462996f,1.30960f,0.444634f,0.0991238f,0.0322136f,0.163809f,0.244963f,1.23201f,-0.216087f,-0.216923f,4.06624f,1.01012f,
+3.21064f,2.66064f,2.37063f,1.62980f,2.70108f,2.92048f,0.958910f,2.79195f,2.85180f,0.611039f,2.45252f,2.48533f,
+0.840695f,1.10182f,2.21989f,3.20831f,2.11605f,1.67975f,1.46182f,1.61353f,1.57562f,2.04037f,0.769781f,1.42019f,
+2.32242f,2.42019f,2.47752f,0.467386f,1.03090f,2.35371f,1.42343f,0.481728f,2.06404f,3.12936f,0.407170f,1.97145f,
+1.57432f,-0.00605292f,0.231052f,1.08460f,-0.520382f,-0.657574f,1.68681f,1.48526f,1.28301f,-0.0208674f,0.199279f,1.27840f,
+3.32602f,2.23066f,4.58487f,2.80568f,2.96501f,1.00477f,2.15617f,0.386253f,0.429966f,4.70520f,1.24247f,-0.444662f,
+-1.12821f,-0.303554f,3.07834f,2.29012f,2.31355f,1.54217f,2.64681f,3.95497f,-0.540567f,1.91707f,2.28640f,0.152059f,
+0.424200f,1.75739f,-1.62973f,0.866164f,2.09768f,-0.409148f,0.841921f,-2.89383f,-1.13838f,-1.72680f,-2.60104f,-1.05690f,
+-2.28778f,-2.13859f,-0.527045f,-1.75384f,-0.0389601f,0.566765f,-1.42894f,-1.11796f,0.166853f,2.20563f,1.85381f,-0.553948f,
+0.868255f,1.21466f,1.05670f,-2.07731f,0.0707222f,-1.79364f,-0.633882f,-1.13138f,-0.613076f,-0.394102f,-0.643546f,-0.967173f,
+0.886702f,1.71628f,1.14059f,1.29259f,1.48598f,-0.742364f,0.603806f,1.46037f,1.27399f,2.84396f,1.94874f,1.39556f,
+0.987074f,1.40834f,1.94505f,0.501023f,1.36569f,2.10865f,0.198083f,1.16179f,1.07451f,0.422629f,0.0761497f,0.713135f,
+1.14139f,0.329650f,3.13943f,2.02016f,2.51972f,-0.0766660f,-0.158017f,-0.369831f,-0.148005f,1.41447f,1.42680f,4.36764f,
+2.31200f,3.11110f,1.34647f,0.895280f,0.0577775f,0.699073f,1.45716f,-0.735795f,0.528833f,3.21768f,1.40335f,1.59086f,
+2.46424f,0.928896f,-1.08632f,0.129886f,-0.223767f,0.0646922f,-0.765613f,-0.692767f,-0.416939f,2.27813f,0.718918f,2.40969f,
+0.685360f,1.48553f,-0.388173f,0.423843f,0.892431f,-0.200199f,5.51713f,-0.575296f,-0.261835f,-1.95407f,-1.18452f,2.18609f,
+0.624580f,0.795366f,0.669586f,1.20696f,2.34341f,-1.44959f,0.129276f,1.06508f,-0.328473f,-0.474289f,0.510415f,-1.46421f,
+1.46123f,-0.00480128f,-1.12191f,-1.11289f,-0.693318f,0.0695863f,-1.20418f,-2.04038f,-1.06658f,-0.990969f,-0.0401703f,0.698219f,
+-0.156574f,-0.580058f,-0.560147f,-1.63461f,-1.44154f,-1.08967f,0.0910982f,-0.831934f,0.389009f,1.65546f,-0.241138f,-0.281498f,
+-0.0853121f,-0.231479f,0.0922119f,0.459643f,-1.14529f,-0.983773f,-1.03193f,-0.0444577f,0.338492f,1.63395f,0.792906f,-0.0207691f,
+0.115928f,-0.254518f,0.422097f,1.58468f,-0.0616638f,-0.0511607f,4.03607f,0.167976f,2.85306f,2.58184f,2.49107f,1.21733f,
+2.52053f,2.69406f,0.795297f,2.80820f,2.83796f,0.460075f,2.55402f,2.24701f,0.768657f,1.04847f,2.28838f,3.11282f,
+2.27181f,1.68185f,1.73033f,1.60920f,1.63234f,2.13388f,0.638182f,1.82726f,2.50550f,2.31990f,2.51749f,0.371603f,
+1.43534f,2.46506f,1.59585f,0.315832f,2.03418f,3.19940f,0.198643f,2.26661f,1.48406f,-0.0525416f,0.0228857f,1.15759f,
+-0.785767f,-0.998569f,1.55034f,1.88851f,1.45512f,-0.260953f,0.391179f,1.70694f,3.42865f,2.38825f,3.22393f,3.07881f,
+3.41988f,0.922712f,2.33112f,0.645963f,0.584120f,4.50078f,1.39551f,-0.386881f,-1.60162f,-0.208165f,3.32136f,2.44865f,
+1.79040f,1.05997f,3.02611f,2.41753f,-0.502590f,2.07619f,2.73392f,0.238381f,0.661043f,2.10492f,-1.55269f,1.01149f,
+1.86173f,-0.872352f,0.809900f,-3.89778f,-1.57446f,-1.72195f,-2.99736f,-1.47477f,-2.63666f,-2.45817f,-0.551213f,-1.76926f,
+-0.257455f,0.449954f,-1.64395f,-1.08727f,0.453161f,1.07358f,2.03983f,-0.696431f,0.989977f,2.05830f,1.62605f,-2.39387f,
+-0.0628124f,-2.24420f,-0.748765f,-1.20220f,-0.616551f,-0.312365f,-1.14446f,-1.50853f,0.758764f,1.56765f,1.39327f,0.551065f,
+1.75885f,-0.726509f,0.856413f,1.57711f,1.84971f,2.87582f,2.03472f,1.36307f,0.736924f,1.36611f,1.97127f,0.488326f,
+1.64929f,1.98174f,0.0463116f,1.36704f,0.653257f,0.0741374f,0.0134705f,0.595011f,1.21571f,0.499839f,3.20667f,2.56471f,
+2.77838f,-0.0875690f,-0.202011f,-0.812850f,-0.347396f,1.51791f,1.42808f,4.42813f,2.23495f,3.47390f,1.03235f,0.973396f,
+0.225474f,0.740711f,1.49760f,-0.624657f,0.482285f,3.33879f,1.55041f,1.89272f,2.62806f,0.797991f,-1.21586f,0.408810f,
+-0.319232f,0.00881336f,-1.19029f,-1.14111f,-0.564017f,2.06927f,0.950553f,1.78969f,0.871996f,1.57236f,-0.645341f,0.401181f,
+1.38674f,-0.120607f,4.52833f,-0.252312f,-0.118716f,-2.25930f,-1.15880f,2.49407f,0.904489f,0.499618f,0.818230f,1.32565f,
+1.18688f,-1.19612f,0.211722f,1.14016f,-0.435670f,-0.763229f,0.307756f,-1.18037f,1.27095f,0.146009f,-1.55772f,-1.47386f,
+-0.888970f,0.184801f,-1.09278f,-2.28181f,-1.32752f,-1.39219f,-0.394298f,0.607306f,-0.166567f,-0.610377f,-0.145225f,-2.00776f,
+-1.37939f,-1.37747f,0.0324333f,-0.785815f,0.758052f,2.13640f,-0.259564f,-0.483552f,-0.407407f,-0.432805f,0.272406f,0.722311f,
+-1.25443f,-0.972875f,-1.36130f,-0.154549f,0.475797f,1.99869f,0.324827f,0.228914f,0.102182f,0.118439f,0.720409f,1.85428f,
+0.162752f,-0.262774f,3.82927f,0.288573f,2.42249f,2.47543f,2.62136f,1.21371f,2.74880f,2.68445f,0.813940f,2.76484f,
+3.06295f,0.716221f,2.60105f,2.46539f,0.905787f,0.916140f,2.32091f,2.99732f,2.31967f,1.41496f,1.88990f,1.55713f,
+1.79863f,2.36048f,0.637138f,1.74163f,2.38484f,2.55210f,2.45973f,0.0784738f,1.64004f,2.32717f,1.31083f,-0.0418162f,
+1.40504f,2.92987f,0.271719f,2.57084f,1.45594f,0.269609f,0.145538f,1.24801f,-0.942690f,-0.778661f,1.56317f,1.95665f,
+1.43071f,0.237324f,0.201607f,2.05158f,3.57709f,2.49283f,1.43182f,3.07542f,3.53328f,0.684165f,2.57566f,0.797696f,
+0.443228f,3.11158f,1.11276f,-0.0478379f,-1.45927f,0.0847229f,3.68986f,2.77283f,0.377127f,0.635868f,2.09665f,0.735813f,
+-0.400363f,2.03307f,2.90706f,0.290259f,0.853464f,2.52032f,-0.846756f,1.07952f,0.585413f,-0.526881f,0.702018f,-2.31466f,
+-1.86062f,-0.752147f,-2.19978f,-1.40820f,-0.824215f,-1.91378f,-0.370344f,-0.606541f,0.00330670f,0.153367f,-1.22921f,-0.432388f,
+0.105161f,0.209751f,1.76052f,-0.906271f,1.34148f,1.65984f,2.17029f,-1.77192f,0.240674f,-2.16008f,-0.767247f,-0.371747f,
+-0.251107f,0.185412f,-0.919451f,-2.34373f,0.338957f,0.214580f,0.450779f,0.0364704f,0.623164f,-1.22141f,0.970758f,0.576610f,
+1.02930f,3.08388f,2.13026f,1.46320f,0.118288f,1.08868f,1.85519f,0.963120f,1.48304f,1.99606f,0.188261f,1.83280f,
+0.625790f,-0.00264763f,-0.933882f,0.411631f,1.57185f,0.557643f,3.32949f,2.64451f,3.03676f,-0.249089f,0.273144f,-1.10178f,
+-0.639123f,1.48334f,1.39920f,4.14444f,1.61192f,2.84622f,0.716123f,0.473383f,-0.291116f,0.607430f,1.51185f,-0.768111f,
+0.201435f,2.98799f,0.837960f,1.76149f,2.46303f,0.231780f,-0.989010f,0.865209f,-0.819821f,0.213087f,-1.12434f,-0.641065f,
+-0.00612203f,2.13747f,1.16812f,0.678941f,0.823357f,1.38664f,-0.890044f,0.0576537f,2.00474f,0.376626f,2.54026f,-0.0959224f,
+0.266816f,-2.10444f,-1.14118f,1.83223f,1.26099f,0.163213f,0.663758f,0.939312f,0.375869f,-0.923866f,0.577101f,1.10908f,
+-0.419017f,-0.791855f,0.246583f,-0.508869f,1.43639f,0.113078f,-0.807356f,-1.58848f,-0.651954f,-0.340127f,-0.583920f,-1.15063f,
+-1.05082f,-0.609299f,-0.321668f,0.136676f,-0.225539f,-0.0687152f,0.0286965f,-1.03057f,-0.328685f,-0.444526f,0.0993873f,-0.0746952f,
+0.922127f,2.08768f,-0.313685f,-0.512973f,-0.572151f,0.203230f,-0.209175f,0.257167f,-0.770379f,0.0329492f,-0.812621f,-0.261132f,
+-0.362098f,0.857884f,0.118086f,0.329566f,0.0381544f,0.160878f,0.156101f,1.00938f,0.149490f,0.0489928f,3.73360f,0.476017f,
+2.28728f,2.46390f,2.62878f,1.24621f,2.76276f,3.08394f,0.902800f,3.01613f,2.94588f,1.24927f,2.33478f,2.72617f,
+1.39193f,1.00350f,2.62635f,3.06585f,2.63254f,1.66940f,1.84362f,1.64145f,1.95619f,1.65721f,0.785205f,2.07037f,
+2.10361f,1.81687f,1.58809f,-0.0825899f,0.485915f,1.90177f,0.494475f,0.124911f,0.334223f,1.39556f,0.735683f,2.46903f,
+0.997976f,0.231097f,0.410948f,0.810591f,-0.334132f,-0.551362f,0.383357f,1.61504f,0.324753f,0.495961f,0.191564f,1.27998f,
+2.75254f,2.49497f,0.334770f,1.20371f,1.99663f,0.860022f,2.76702f,1.18358f,0.722868f,0.765662f,0.384551f,0.475493f,
+-0.325354f,0.378053f,1.44311f,3.12536f,0.0549120f,0.194388f,0.186243f,0.0756100f,-0.0228455f,0.435005f,0.404820f,0.582420f,
+0.145530f,1.32244f,0.0341209f,0.306727f,0.0401642f,-0.0499868f,0.186074f,-0.137135f,-0.189591f,0.0564407f,-0.114090f,-0.135449f,
+-0.0230140f,-0.0951536f,-0.0107458f,-0.0242971f,-0.00505384f,0.00909700f,-0.0228221f,-0.00282564f,0.0200054f,0.0281388f,0.289772f,-0.749576f,
+0.692015f,0.120013f,0.960506f,-0.0390015f,0.0974154f,-0.286170f,-0.0347454f,-0.0563254f,-0.0482066f,-0.000726336f,-0.0961146f,-0.393125f,
+-0.0216301f,0.00936075f,0.0585182f,-0.000805461f,0.00248874f,-0.215477f,0.0514708f,0.0296329f,0.0466390f,2.92180f,2.08798f,1.35599f,
+-0.185932f,0.897613f,1.52508f,0.700509f,1.16834f,2.03377f,1.06389f,1.46623f,0.371720f,0.233237f,-0.347844f,0.987299f,
+1.76852f,0.496429f,3.30589f,1.63315f,2.78873f,-0.469645f,0.595204f,-0.442941f,-0.389644f,1.30328f,0.972519f,2.27885f,
+0.214089f,0.728637f,1.03890f,0.243020f,-0.0134641f,0.291694f,0.836185f,-0.574550f,0.571277f,1.69506f,0.341350f,0.623308f,
+0.979433f,-0.0600526f,-0.385093f,0.370207f,0.378052f,0.0817738f,-0.147556f,-0.122667f,0.535718f,1.07736f,0.879070f,0.128310f,
+0.385093f,0.530905f,-0.700606f,0.161999f,1.64012f,0.0133484f,0.430814f,0.179579f,0.493389f,-0.332057f,-0.0567455f,0.495336f,
+0.930701f,0.0426277f,0.193322f,0.208988f,0.0227646f,0.0833930f,0.232265f,0.0696766f,0.282624f,-0.0558786f,0.550124f,0.0754669f,
+0.232474f,0.00166916f,-0.0192110f,-0.0603507f,-0.00350129f,-0.0993982f,0.0211285f,-0.0589290f,-0.0129598f,-0.0164542f,-0.0256018f,0.0698437f,
+-0.00303367f,-0.0191657f,0.00726447f,-0.0441243f,0.00485273f,0.0301778f,0.0123167f,0.124897f,-0.00629573f,0.685868f,0.0608329f,0.131042f,
+-0.0248092f,0.0748117f,-0.0341259f,-0.0170847f,-0.0116167f,0.0114289f,0.0111660f,-0.0513082f,-0.0940072f,0.00704572f,-0.000131362f,0.0729988f,
+0.00116671f,0.00583667f,-0.108959f,0.0904876f,0.00704751f,0.0614693f,3.33725f,0.463450f,2.70998f,2.87249f,2.99055f,1.61355f,
+2.94810f,3.10431f,1.70815f,2.92620f,1.92363f,0.248190f,0.150237f,2.57990f,0.360244f,0.143968f,0.652154f,1.20339f,
+2.71962f,1.06000f,0.0597362f,0.331403f,1.89038f,0.0632227f,0.115216f,0.495172f,0.105318f,0.136779f,0.118999f,-0.00286829f,
+-0.00602030f,0.148287f,0.00489796f,-0.000563894f,-0.00136564f,0.0725829f,0.389458f,0.542571f,0.218921f,0.00698257f,0.00947694f,0.0190748f,
+-0.00494550f,0.0109010f,-0.00145769f,0.320306f,0.000349574f,0.0220075f,0.00373749f,0.00883274f,0.538814f,2.39223f,0.0139031f,0.0667061f,
+0.0999197f,0.160520f,0.419305f,0.119037f,0.366202f,0.00316429f,0.00525855f,0.00308891f,0.00714951f,-0.00347130f,0.0257303f,0.291139f,
+0.00106630f,0.00162476f,0.00404945f,0.000190260f,0.0110912f,0.00441028f,0.0106551f,0.0256762f,0.00337853f,0.0136108f,0.000333622f,-0.00734719f,
+0.000959619f,0.000829185f,0.00195559f,0.00000f,0.000275345f,-2.23654e-05f,0.000268524f,-0.000195014f,0.00000f,0.000123753f,-0.00118263f,0.00000f,
+0.000758525f,0.00000f,0.000198361f,0.00000f,0.000140219f,-0.000509618f,-5.05751e-05f,-0.00802251f,0.00223657f,0.00208178f,0.0165086f,-0.000397398f,
+0.000490361f,0.00000f,-0.000206673f,-0.000970374f,0.00000f,-0.00190453f,0.00000f,-9.73635e-05f,-0.000252832f,0.00000f,8.02256e-05f,0.00000f,
+0.00000f,-0.000785210f,-0.000973223f,0.00000f,0.00000f,2.06332f,1.46097f,1.15640f,0.512989f,1.25468f,1.06363f,0.899441f,
+1.64850f,1.42024f,0.111064f,0.0870986f,1.36933f,0.197744f,0.0294973f,0.299705f,0.740860f,1.05629f,1.53222f,0.0573340f,
+0.334854f,0.904171f,0.0402585f,0.0274060f,0.254302f,0.0422377f,0.101497f,0.123908f,-5.90834e-05f,0.0173826f,0.106414f,0.00172178f,
+-0.000695930f,0.00268080f,0.0139203f,0.119105f,0.287347f,0.176115f,0.00726512f,0.00747650f,0.0120305f,-0.00102297f,-0.00390991f,0.00278496f,
+0.207786f,-0.00142202f,0.00617021f,-0.00143924f,0.00276557f,0.0929152f,0.180630f,0.0104449f,0.0338990f,0.0195746f,0.0388082f,0.136930f,
+0.0935322f,0.158701f,0.00281793f,0.00978737f,0.00906596f,0.00312246f,0.00699570f,0.00856936f,0.148972f,0.000633666f,0.00738283f,0.00472620f,
+0.00110398f,0.00332578f,0.00143460f,0.00201674f,0.0170965f,0.00144758f,0.0215585f,-0.00112384f,0.000567346f,0.00000f,0.000323741f,0.00309256f,
+0.00000f,-0.00281556f,0.00000f,-0.000330808f,-5.64704e-05f,0.00000f,0.000646684f,0.000573839f,0.00000f,0.00000f,0.00000f,-0.000141944f,
+0.00000f,0.00000f,0.00000f,0.00185547f,-0.00247132f,0.00506563f,0.00310006f,0.00987413f,5.11913e-05f,0.00000f,0.00000f,0.000145997f,
+0.00146693f,0.00103148f,0.000105816f,0.00000f,9.39198e-05f,0.00000f,0.00000f,0.000164492f,0.00000f,0.00000f,-0.000676360f,0.000513713f,
+0.00000f,0.00000f,1.48489f,0.192221f,
+}};
+
+}// namespace entropy
@@ -28,6 +28,8 @@ public:
 
     uint get_open_spaces() const { return open_spaces; }
 
+    std::uint64_t get_value() const { return hash; }
+
     bool operator==(const ZobristHash &o) const { return hash == o.hash && open_spaces == o.open_spaces; }
 
 private:
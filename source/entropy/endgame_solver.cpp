@@ -0,0 +1,141 @@
+#include "entropy/endgame_solver.hpp"
+
+#include <algorithm>
+
+namespace entropy {
+
+namespace {
+
+struct ScoredOrderMove {
+    OrderMove move;
+    int score;
+};
+
+struct ScoredPlacement {
+    Position pos;
+    uint score;
+};
+
+// Order moves with the largest immediate gain first, they are the likeliest to reach the cutoff
+uint sorted_order_moves(const BoardState &board, ScoredOrderMove *moves) {
+    uint n = 0;
+    moves[n++] = {{}, 0};
+    board.get_minimal_state().for_each_possible_order_move_with_score([&n, moves](auto from, auto to, int score) {
+        moves[n++] = {{from, to}, score};
+    });
+    std::sort(moves, moves + n, [](const auto &a, const auto &b) { return a.score > b.score; });
+    return n;
+}
+
+// Placements with the smallest immediate gain first, they give the tightest bound for the order moves after them
+uint sorted_placements(const BoardState &board, Colour colour, ScoredPlacement *placements) {
+    uint n = 0;
+    board.get_minimal_state().for_each_possible_chaos_move_with_score(colour, [&n, placements](auto p, uint score) {
+        placements[n++] = {p, score};
+    });
+    std::sort(placements, placements + n, [](const auto &a, const auto &b) { return a.score < b.score; });
+    return n;
+}
+
+}// namespace
+
+EndgameSolution<OrderMove> EndgameSolver::solve_order(const BoardState &board, const ChipPool &pool) {
+    ScoredOrderMove moves[MAX_POSSIBLE_ORDER_MOVES + 1];
+    const uint n = sorted_order_moves(board, moves);
+
+    EndgameSolution<OrderMove> best{{}, -std::numeric_limits<float>::infinity()};
+    for (uint i = 0; i < n; ++i) {
+        BoardState next = board;
+        next.move_chip(moves[i].move);
+
+        const float value = chaos_value(next, pool);
+        if (value > best.score) best = {moves[i].move, value};
+    }
+    return best;
+}
+
+EndgameSolution<Position> EndgameSolver::solve_chaos(const BoardState &board, const ChipPool &pool, Colour colour) {
+    ScoredPlacement placements[BOARD_AREA];
+    const uint n = sorted_placements(board, colour, placements);
+    const ChipPool next_pool(pool, colour);
+
+    EndgameSolution<Position> best{{}, std::numeric_limits<float>::infinity()};
+    for (uint i = 0; i < n; ++i) {
+        BoardState next = board;
+        next.place_chip({placements[i].pos, colour});
+
+        const float value = order_value(next, next_pool, best.score);
+        if (value < best.score) best = {placements[i].pos, value};
+    }
+    return best;
+}
+
+float EndgameSolver::order_value(const BoardState &board, const ChipPool &pool, float beta) {
+    ++statistics.nodes;
+    const uint open_cells = board.get_open_cells();
+    if (!open_cells) return float(board.get_total_score());
+
+    const auto key = key_of(board, true);
+    if (const Entry *entry = probe(key, open_cells); entry && (!entry->lower_bound || entry->value >= beta)) {
+        ++statistics.table_hits;
+        return entry->value;
+    }
+
+    ScoredOrderMove moves[MAX_POSSIBLE_ORDER_MOVES + 1];
+    const uint n = sorted_order_moves(board, moves);
+
+    float best = -std::numeric_limits<float>::infinity();
+    for (uint i = 0; i < n; ++i) {
+        BoardState next = board;
+        next.move_chip(moves[i].move);
+
+        best = std::max(best, chaos_value(next, pool));
+        if (best >= beta) {
+            store(key, open_cells, best, true);
+            return best;
+        }
+    }
+
+    store(key, open_cells, best);
+    return best;
+}
+
+float EndgameSolver::chaos_value(const BoardState &board, const ChipPool &pool) {
+    ++statistics.nodes;
+    const uint open_cells = board.get_open_cells();
+    if (!open_cells) return float(board.get_total_score());
+
+    const auto key = key_of(board, false);
+    if (const Entry *entry = probe(key, open_cells)) {
+        ++statistics.table_hits;
+        return entry->value;
+    }
+
+    // The pool holds exactly one chip per open cell
+    float total = 0;
+    for (uint c = 1; c < BOARD_COLOURS; ++c) {
+        if (const uint n = pool.chips_left(Colour(c))) total += float(n) * placement_value(board, pool, Colour(c));
+    }
+    const float value = total / float(open_cells);
+
+    store(key, open_cells, value);
+    return value;
+}
+
+float EndgameSolver::placement_value(const BoardState &board, const ChipPool &pool, Colour colour) {
+    return solve_chaos(board, pool, colour).score;
+}
+
+const EndgameSolver::Entry *EndgameSolver::probe(std::uint64_t key, uint open_spaces) {
+    if (table.empty()) table.resize(TABLE_SIZE);
+
+    const Entry &entry = table[key & (TABLE_SIZE - 1)];
+    return entry.key == key && entry.open_spaces == open_spaces ? &entry : nullptr;
+}
+
+// Always replaces, the entries of earlier moves are the ones the search is least likely to reach again
+void EndgameSolver::store(std::uint64_t key, uint open_spaces, float value, bool lower_bound) {
+    table[key & (TABLE_SIZE - 1)] = {key, value, uint8_t(open_spaces), lower_bound};
+}
+
+}// namespace entropy
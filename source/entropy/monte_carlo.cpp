@@ -1,156 +1,241 @@
 #include "entropy/monte_carlo.hpp"
+#include "entropy/rollout_board.hpp"
+#include "entropy/value_function.hpp"
+
+#include <thread>
 
 namespace entropy::mcts {
 
-FastRand RNG{};
-OrderNodeBuffer order_node_buffer{};
-ChaosNodeBuffer chaos_node_buffer{};
-
-inline void do_smart_order_move(MinimalBoardState &board,
-                                uint &s) {
-    OrderMove::Compact moves_buf[MAX_POSSIBLE_ORDER_MOVES];
-
-    moves_buf[0].make_pass();
-    uint n = 1;
-    int best_score = 0;
-    board.for_each_possible_order_move_with_score([&n, &moves_buf, &best_score](auto from, auto to, int score) {
-        if (score >= best_score) {
-            if (score > best_score) {
-                best_score = score;
-                n = 0;
-            }
-            moves_buf[n++] = {from, to};
+thread_local FastRand RNG{};
+
+// Keeps the candidate that is the largest in `rank` and then in `value`, equal candidates are chosen uniformly at random
+template <typename Move>
+struct MastChoice {
+    void offer(Move candidate, int rank, float value, uint score) {
+        if (rank < best_rank || (rank == best_rank && value < best_value)) return;
+        if (rank > best_rank || value > best_value) {
+            best_rank = rank;
+            best_value = value;
+            ties = 0;
+        }
+        if (!(RNG() % ++ties)) {
+            move = candidate;
+            move_score = score;
         }
+    }
+
+    Move move{};
+    uint move_score = 0;
+    int best_rank = std::numeric_limits<int>::min();
+    float best_value = -std::numeric_limits<float>::infinity();
+    uint ties = 0;
+};
+
+// Whether a MAST move ranks the moves by their value alone instead of by their immediate score first
+inline bool mast_explores() { return float(RNG()) < MAST_EXPLORATION * float(FastRand::max() + 1); }
+
+// Uniform in [0, MAST_NOISE), added to the values so that moves with close values are all played, like Gibbs sampling
+// without its exponentials
+inline float mast_noise() { return MAST_NOISE / float(FastRand::max() + 1) * float(RNG()); }
+
+// The MAST rollout policy: the moves of the greedy policy in do_smart_order_move and do_smart_chaos_move, of which the
+// one with the best perturbed value, or with MAST_EXPLORATION the move with the best perturbed value of all. `unknown`
+// is the value of a move without iterations.
+inline OrderMove::Compact do_mast_order_move(RolloutBoard &board, uint &s, const MoveValueTable &policy, float unknown) {
+    const int greedy = !mast_explores();
+
+    MastChoice<OrderMove::Compact> choice;
+    OrderMove::Compact pass;
+    pass.make_pass();
+    choice.offer(pass, 0, unknown + mast_noise(), 0);
+    board.for_each_possible_order_move_with_score([&choice, &policy, unknown, greedy](auto from, auto to, int score) {
+        const OrderMove::Compact move{from, to};
+        choice.offer(move, greedy * score, policy.order_value(move, unknown) + mast_noise(), uint(score));
     });
 
-    auto it = random_element(moves_buf, n, RNG);
-    if (!it->is_pass()) {
-        auto m = it->create();
+    if (!choice.move.is_pass()) {
+        const auto m = choice.move.create();
         board.move_chip(m.from, m.to);
-
-        s += best_score;
+        s += choice.move_score;
     }
+    return choice.move;
 }
 
-inline void do_smart_chaos_move(MinimalBoardState &board,
-                                uint &s,
-                                uint open_cells,
-                                std::array<uint8_t, BOARD_AREA> &chips) {
-    uint8_t moves_buf[BOARD_AREA];
-
+inline ChaosMove do_mast_chaos_move(RolloutBoard &board,
+                                    uint &s,
+                                    uint open_cells,
+                                    std::array<uint8_t, BOARD_AREA> &chips,
+                                    const MoveValueTable &policy,
+                                    float unknown) {
     auto rand_it = random_element(chips.begin(), open_cells, RNG);
     const Colour colour = *rand_it;
     *rand_it = chips[open_cells - 1];
+    const int greedy = !mast_explores();
 
-    uint n = 0;
-    uint best_score = -1u;
-    board.for_each_possible_chaos_move_with_score(colour, [&n, &moves_buf, &best_score](auto p, uint score) {
-        if (score == best_score) moves_buf[n++] = p.p;
-        else if (score < best_score) {
-            moves_buf[0] = p.p;
-            best_score = score;
-            n = 1;
-        }
+    // Chaos minimises, so both keys are negated
+    MastChoice<Position> choice;
+    board.for_each_possible_chaos_move_with_score(colour, [&choice, &policy, unknown, greedy, colour](Position p, uint score) {
+        choice.offer(p, -greedy * int(score), mast_noise() - policy.chaos_value(p, colour, unknown), score);
     });
 
-    Position p = *random_element(moves_buf, n, RNG);
-    board.place_chip(p.row(), p.column(), colour);
-
-    s += best_score;
+    board.place_chip(choice.move.row(), choice.move.column(), colour);
+    s += choice.move_score;
+    return {choice.move, colour};
 }
 
-inline void smart_rollout_helper(MinimalBoardState &board,
+// Plays until the board is full or `cut_after` more chips have been placed, the value function estimates the rest
+inline void smart_rollout_helper(RolloutBoard &board,
                                  uint &score,
                                  uint open_cells,
-                                 std::array<uint8_t, BOARD_AREA> &chips) {
-    while (open_cells) {
-        do_smart_order_move(board, score);
-        do_smart_chaos_move(board, score, open_cells, chips);
-        --open_cells;
+                                 std::array<uint8_t, BOARD_AREA> &chips,
+                                 uint cut_after,
+                                 SimulationMoves *moves,
+                                 const MoveValueTable *policy) {
+    const float unknown = policy ? policy->mean() : 0;
+    for (; open_cells; --open_cells, --cut_after) {
+        if (!cut_after) {
+            score = uint(std::max(0.f, float(score) + estimate_value_gain(board, open_cells, chips)) + .5f);
+            return;
+        }
+        const auto order_move = policy ? do_mast_order_move(board, score, *policy, unknown) : do_smart_order_move(board, score, RNG);
+        const auto placement = policy ? do_mast_chaos_move(board, score, open_cells, chips, *policy, unknown)
+                                      : do_smart_chaos_move(board, score, open_cells, chips, RNG);
+        if (moves) {
+            moves->add(order_move);
+            moves->add(placement);
+        }
     }
 }
 
-uint smart_rollout_order(const BoardState &original, const ChipPool &pool) {
+uint smart_rollout_order(const BoardState &original, const ChipPool &pool, uint cut_after, SimulationMoves *moves,
+                         const MoveValueTable *policy) {
     auto chips = pool.create_array();
-    auto copy = original.get_minimal_state();
+    RolloutBoard copy(original.get_minimal_state());
 
     uint score = original.get_total_score();
-    smart_rollout_helper(copy, score, original.get_open_cells(), chips);
+    smart_rollout_helper(copy, score, original.get_open_cells(), chips, cut_after, moves, policy);
 
     return score;
 }
 
-uint smart_rollout_chaos(const BoardState &original, const ChipPool &pool) {
+// The first chip is always placed, the value function estimates positions with order to move
+uint smart_rollout_chaos(const BoardState &original, const ChipPool &pool, uint cut_after, SimulationMoves *moves,
+                         const MoveValueTable *policy) {
     if (!original.get_open_cells()) return original.get_total_score();
     auto chips = pool.create_array();
-    auto copy = original.get_minimal_state();
+    RolloutBoard copy(original.get_minimal_state());
 
     uint score = original.get_total_score();
-    do_smart_chaos_move(copy, score, original.get_open_cells(), chips);
-    smart_rollout_helper(copy, score, original.get_open_cells() - 1, chips);
+    const auto placement = policy ? do_mast_chaos_move(copy, score, original.get_open_cells(), chips, *policy, policy->mean())
+                                  : do_smart_chaos_move(copy, score, original.get_open_cells(), chips, RNG);
+    if (moves) moves->add(placement);
+    smart_rollout_helper(copy, score, original.get_open_cells() - 1, chips, cut_after ? cut_after - 1 : 0, moves, policy);
 
     return score;
 }
 
-template <typename T, typename F>
-inline T *select_child_helper(const std::vector<std::shared_ptr<T>> &vec, F &&evaluator) {
-    auto best_score = std::forward<F>(evaluator)(*vec.front());
-    auto child = vec.begin();
-
-    for (auto it = child + 1; it != vec.end(); ++it) {
-        auto s = std::forward<F>(evaluator)(**it);
-        if (s > best_score) {
-            best_score = s;
-            child = it;
-        }
-    }
+// Nodes hold no resources, so that SearchEnvironment::reset can forget them without destroying each one
+static_assert(std::is_trivially_destructible_v<OrderNode>);
+static_assert(std::is_trivially_destructible_v<ChaosNode>);
+static_assert(std::is_trivially_destructible_v<ChaosEdges>);
 
-    return child->get();
+OrderNode::OrderNode(const ChaosNode &parent,
+                     const ChaosMove &new_move) : board(parent.board), pool(parent.pool, new_move.colour) {
+    board.place_chip(new_move);
 }
 
-OrderNode::OrderNode(ChaosNode *p,
-                     const ChaosMove &new_move) : board(p->board), pool(p->pool, new_move.colour), parents{{p, new_move}} {
-    board.place_chip(new_move);
+void OrderNode::init(const SearchEnvironment &environment) {
+    std::fill_n(edge_slots, ORDER_EDGE_KEYS, NO_EDGE);
+
+    float gains[MAX_POSSIBLE_ORDER_MOVES];
+    gains[0] = 0;
+    unvisited.push(ORDER_EDGE_KEYS - 1);
+    board.get_minimal_state().for_each_possible_order_move_with_score([this, &gains](auto from, auto to, int score) {
+        gains[unvisited.size()] = float(score);
+        unvisited.push(order_edge_key({from, to}));
+    });
+    unvisited.sort(gains, 1, ORDER_PRIOR_SCALE, environment.progressive_widening, RNG);
+    moves = uint8_t(unvisited.size());
+    if (environment.rave) amaf = environment.order_amaf_arena->create();
+
+    initialized.store(true, std::memory_order_release);
 }
 
-OrderNode::~OrderNode() {
-    while (!children.empty()) {
-        if (!children.back().unique()) children.back()->parents.erase(this);
-        children.pop_back();
+bool OrderNode::try_add_child(SearchEnvironment &environment, uint &rollout_score, SimulationMoves *moves) {
+    uint key;
+    {
+        std::lock_guard lock(expansion_lock);
+        if (!unvisited.may_take(environment.progressive_widening, total_visits, statistics.proven_count)) return false;
+
+        key = unvisited.take();
+    }
+    const OrderMove::Compact move = order_edge_move(board.get_minimal_state(), key);
+
+    const NodeIndex child = environment.get_chaos_node(*this, move.create());
+    if (child == NULL_NODE) {// out of node memory, the move stays unvisited and the search goes on without expanding
+        std::lock_guard lock(expansion_lock);
+        unvisited.put_back(key);
+        return false;
     }
+    if (moves) moves->add(move);
+    rollout_score = environment.chaos_node(child).rollout(environment.leaf_rollouts, environment.rollout_chips, moves, environment.rollout_policy());
+    environment.chaos_node(child).record_score(rollout_score, 0);
+    const float gain = float(environment.chaos_node(child).board.get_total_score()) - float(board.get_total_score());
+
+    std::lock_guard lock(expansion_lock);
+    const uint slot = published.load(std::memory_order_relaxed);
+    edges[slot] = {move, child};
+    statistics.init(slot, rollout_score, unvisited.prior(gain));
+    if (environment.chaos_node(child).solved.is_proven()) statistics.prove(slot);
+    edge_slots[key] = uint8_t(slot);
+    published.store(slot + 1, std::memory_order_release);
+    return true;
 }
 
-void OrderNode::init() {
-    initialized = true;
+uint OrderNode::select_edge(const SearchEnvironment &environment) const {
+    const uint n = published.load(std::memory_order_acquire);
+    return n ? statistics.select<false>(n, log_visits(total_visits), environment.uct_temperature,
+                                        environment.prior_exploration(total_visits), environment.order_amaf(amaf))
+             : NO_EDGE;
+}
 
-    moves[unvisited++].make_pass();
-    board.get_minimal_state().for_each_possible_order_move([this](auto from, auto to) {
-        moves[unvisited++] = {from, to};
-    });
+void OrderNode::record_amaf(SearchEnvironment &environment, const SimulationMoves &moves, uint first, uint score) {
+    if (amaf == NULL_NODE) return;
 
-    children.reserve(std::max(unvisited / 3, 2u));
+    auto &statistics = (*environment.order_amaf_arena)[amaf];
+    const uint n = published.load(std::memory_order_acquire);
+    for (uint i = first; i < moves.order_count; ++i) {
+        if (const uint slot = edge_slots[order_edge_key(moves.order_moves[i])]; slot < n) statistics.record(slot, score);
+    }
 }
 
-ChaosNode *OrderNode::add_random_child(SearchEnvironment &environment) {
-    auto it = random_element(moves, unvisited, RNG);
-    auto move = *it;
-    *it = moves[--unvisited];
+void ChaosEdges::record_amaf(SearchEnvironment &environment, const SimulationMoves &moves, uint first, Colour colour, uint score) {
+    if (amaf == NULL_NODE) return;
 
-    children.push_back(environment.get_chaos_node(this, move.create()));
-    return children.back().get();
+    auto &statistics = (*environment.chaos_amaf_arena)[amaf];
+    const uint n = published.load(std::memory_order_acquire);
+    for (uint i = first; i < moves.chaos_count; ++i) {
+        if (const uint slot = edge_slots[moves.chaos_cells[i]]; slot < n && moves.chaos_colours[i] == colour) statistics.record(slot, score);
+    }
 }
 
-ChaosNode *OrderNode::select_child(float uct_temperature) const {
-    const auto logN = std::log(float(total_visits));
-    return select_child_helper(children, [=](const auto &node) {
-        return node.branch_score(logN, uct_temperature);
-    });
+const Edge<OrderMove::Compact> &OrderNode::select_best_edge(SearchEnvironment &environment) const {
+    return edges[statistics.best<false>(published.load(std::memory_order_acquire), [this, &environment](uint i) {
+        return environment.chaos_node(edges[i].node).solved.get();
+    })];
 }
 
-ChaosNode *OrderNode::select_best_node() const {
-    return select_child_helper(children, [](const auto &node) {
-        return node.average_score();
-    });
+bool OrderNode::try_solve(SearchEnvironment &environment) {
+    if (solved.is_proven()) return true;
+    if (!initialized.load(std::memory_order_acquire)) return false;
+
+    const uint n = published.load(std::memory_order_acquire);
+    if (n != moves || statistics.proven_count.load(std::memory_order_relaxed) != n) return false;
+
+    float value = 0;
+    for (uint i = 0; i < n; ++i) value = std::max(value, environment.chaos_node(edges[i].node).solved.get());
+    solved.set(value);
+    return true;
 }
 
 void OrderNode::record_score(uint score) {
@@ -158,66 +243,107 @@ void OrderNode::record_score(uint score) {
     total_score += score;
 }
 
-void OrderNode::add_parent(ChaosNode *parent, const ChaosMove &move) {
-    parents[parent] = move;
-}
-
-ChaosNode::ChaosNode(OrderNode *p,
-                     const OrderMove &new_move) : board(p->board), pool(p->pool), parents{{p, new_move}} {
+ChaosNode::ChaosNode(const OrderNode &parent,
+                     const OrderMove &new_move) : board(parent.board), pool(parent.pool) {
     board.move_chip(new_move);
+    colour_edges.fill(NULL_NODE);
+    if (is_terminal()) solved.set(float(board.get_total_score()));
 }
 
-void ChaosNode::init() {
-    initialized = true;
-
-    const uint N = board.get_open_cells();
-    if (!N) return;
+NodeIndex ChaosNode::get_child(SearchEnvironment &environment, const ChaosMove &move) const {
+    const NodeIndex index = colour_edges[move.colour - 1];
+    if (index == NULL_NODE) return NULL_NODE;
 
-    std::vector<uint8_t> possible_moves;
-    possible_moves.reserve(N);
-
-    board.get_minimal_state().for_each_empty_space([&possible_moves](Position p) {
-        possible_moves.push_back(p.p);
-    });
+    const auto &colour = environment.chaos_edges(index);
+    const uint8_t slot = colour.edge_slots[move.pos.p];
+    return slot == NO_EDGE ? NULL_NODE : colour.edges[slot].node;
+}
 
-    std::vector<uint8_t> *vec{};
-    for (uint i = 0; i < ChipPool::N; ++i) {
-        if (pool.chips_left(i + 1)) {
-            if (vec) unvisited_moves[i] = *vec;
-            else {
-                unvisited_moves[i] = std::move(possible_moves);
-                vec = &unvisited_moves[i];
+bool ChaosNode::try_add_child(Colour colour, SearchEnvironment &environment, uint &rollout_score, SimulationMoves *moves) {
+    ChaosEdges *edges;
+    Position p;
+    {
+        std::lock_guard lock(expansion_lock);
+        auto &index = colour_edges[colour - 1];
+        if (index == NULL_NODE) {
+            const NodeIndex amaf = environment.rave ? environment.chaos_amaf_arena->create() : NULL_NODE;
+            index = environment.chaos_edges_arena->create(board.get_minimal_state(), colour, environment.progressive_widening, amaf);
+            if (index == NULL_NODE) {
+                if (amaf != NULL_NODE) environment.release_chaos_amaf(amaf);
+                return false;
             }
-            children[i].reserve(std::max(N / 3, 2u));
         }
+
+        edges = &environment.chaos_edges(index);
+        if (!edges->unvisited.may_take(environment.progressive_widening, colour_visits(colour), edges->statistics.proven_count)) return false;
+
+        p = edges->unvisited.take();
     }
-}
 
-OrderNode *ChaosNode::add_random_child(Colour colour, SearchEnvironment &environment) {
-    uint index = colour - 1;
+    const NodeIndex child = environment.get_order_node(*this, {p, colour});
+    if (child == NULL_NODE) {
+        std::lock_guard lock(expansion_lock);
+        edges->unvisited.put_back(p.p);
+        return false;
+    }
+    if (moves) moves->add(ChaosMove{p, colour});
+    rollout_score = environment.order_node(child).rollout(environment.leaf_rollouts, environment.rollout_chips, moves, environment.rollout_policy());
+    environment.order_node(child).record_score(rollout_score);
+    const float gain = float(environment.order_node(child).board.get_total_score()) - float(board.get_total_score());
+
+    std::lock_guard lock(expansion_lock);
+    const uint slot = edges->published.load(std::memory_order_relaxed);
+    edges->edges[slot] = {uint8_t(p.p), child};
+    edges->statistics.init(slot, rollout_score, edges->unvisited.prior(gain));
+    if (environment.order_node(child).solved.is_proven()) edges->statistics.prove(slot);
+    edges->edge_slots[p.p] = uint8_t(slot);
+    edges->published.store(slot + 1, std::memory_order_release);
+    return true;
+}
 
-    auto it = random_element(unvisited_moves[index].begin(), unvisited_moves[index].size(), RNG);
-    Position p = *it;
+ChaosEdges *ChaosNode::get_edges(Colour colour, SearchEnvironment &environment) const {
+    const NodeIndex index = colour_edges[colour - 1];
+    return index == NULL_NODE ? nullptr : &environment.chaos_edges(index);
+}
 
-    *it = unvisited_moves[index].back();
-    unvisited_moves[index].pop_back();
-    if (unvisited_moves[index].empty()) unvisited_moves[index] = {};
+uint ChaosNode::select_edge(Colour colour, SearchEnvironment &environment) const {
+    const auto edges = get_edges(colour, environment);
+    const uint n = colour_visits(colour);
+    return edges ? edges->select_edge(log_visits(n), environment.uct_temperature, environment.prior_exploration(n), environment.chaos_amaf(edges->amaf))
+                 : NO_EDGE;
+}
 
-    children[index].push_back(environment.get_order_node(this, {p, colour}));
-    return children[index].back().get();
+const Edge<uint8_t> &ChaosNode::select_best_edge(Colour colour, SearchEnvironment &environment) const {
+    const auto &edges = environment.chaos_edges(colour_edges[colour - 1]);
+    return edges.edges[edges.statistics.best<true>(edges.published.load(std::memory_order_acquire), [&edges, &environment](uint i) {
+        return environment.order_node(edges.edges[i].node).solved.get();
+    })];
 }
 
-OrderNode *ChaosNode::select_child(Colour colour, float uct_temperature) const {
-    const auto logN = std::log(float(visits[colour - 1]));
-    return select_child_helper(children[colour - 1], [=](const auto &node) {
-        return node.branch_score(logN, uct_temperature);
-    });
+bool ChaosEdges::try_solve(SearchEnvironment &environment) {
+    if (solved.is_proven()) return true;
+
+    const uint n = published.load(std::memory_order_acquire);
+    if (n != cells || statistics.proven_count.load(std::memory_order_relaxed) != n) return false;
+
+    float value = std::numeric_limits<float>::max();
+    for (uint i = 0; i < n; ++i) value = std::min(value, environment.order_node(edges[i].node).get_proven_value().get());
+    solved.set(value);
+    return true;
 }
 
-OrderNode *ChaosNode::select_best_node(Colour colour) const {
-    return select_child_helper(children[colour - 1], [](const auto &node) {
-        return -node.average_score();
-    });
+bool ChaosNode::try_solve(SearchEnvironment &environment) {
+    if (solved.is_proven()) return true;
+
+    float value = 0;
+    for (Colour c = 1; c <= ChipPool::N; ++c) {
+        const uint chips = pool.chips_left(c);
+        if (!chips) continue;
+        if (!try_solve(c, environment)) return false;
+        value += float(chips) * get_edges(c, environment)->solved.get();
+    }
+    solved.set(value / float(pool.prefix_sum.back()));
+    return true;
 }
 
 void ChaosNode::record_score(uint score, Colour colour) {
@@ -225,130 +351,454 @@ void ChaosNode::record_score(uint score, Colour colour) {
     total_score += score;
 
     if (colour) {
-        ++visits[colour - 1];
-        scores[colour - 1] += score;
+        colour_entries[colour - 1].fetch_add(pack_visits(1, score), std::memory_order_relaxed);
     }
 }
 
-void ChaosNode::add_parent(OrderNode *parent, const OrderMove &move) {
-    parents[parent] = move;
+float ChaosNode::average_score() const {
+    float sum = 0;
+    uint chips = 0;
+    for (Colour c = 1; c <= ChipPool::N; ++c) {
+        const std::uint64_t entry = colour_entries[c - 1].load(std::memory_order_relaxed);
+        const uint n = unpack_visits(entry);
+        if (!n) continue;
+        sum += float(pool.chips_left(c)) * float(unpack_score(entry)) / float(n);
+        chips += pool.chips_left(c);
+    }
+    return chips ? sum / float(chips) : float(total_score) / float(total_visits);
 }
 
-void ChaosNode::destruct_children(std::vector<std::shared_ptr<OrderNode>> &vec) {
-    while (!vec.empty()) {
-        if (!vec.back().unique()) vec.back()->parents.erase(this);
-        vec.pop_back();
+// The deficit of a colour is its share of the visits so far and of this one, minus its visits, scaled by the chips
+Colour ChaosNode::scheduled_colour() const {
+    std::uint64_t n = 1;
+    for (Colour c = 1; c <= ChipPool::N; ++c) n += colour_visits(c);
+
+    Colour best = 0;
+    std::int64_t best_deficit = std::numeric_limits<std::int64_t>::min();
+    for (Colour c = 1; c <= ChipPool::N; ++c) {
+        const uint chips = pool.chips_left(c);
+        if (!chips) continue;
+        const std::int64_t deficit = std::int64_t(chips * n) - std::int64_t(colour_visits(c)) * pool.prefix_sum.back();
+        if (deficit > best_deficit) {
+            best_deficit = deficit;
+            best = c;
+        }
+    }
+    return best;
+}
+
+void ChaosNode::clear_colours(SearchEnvironment &environment, uint keep) {
+    for (uint c = 0; c < ChipPool::N; ++c) {
+        if (c == keep - 1 || colour_edges[c] == NULL_NODE) continue;
+
+        environment.release_chaos_edges(colour_edges[c]);
+        colour_edges[c] = NULL_NODE;
+
+        const std::uint64_t entry = colour_entries[c].exchange(0, std::memory_order_relaxed);
+        total_visits -= unpack_visits(entry);
+        total_score -= unpack_score(entry);
     }
 }
 
-std::shared_ptr<OrderNode> SearchEnvironment::get_order_node(ChaosNode *parent, const ChaosMove &move) {
-    auto new_hash = parent->board.get_hash();
+NodeIndex SearchEnvironment::get_order_node(const ChaosNode &parent, const ChaosMove &move) {
+    auto new_hash = parent.board.get_hash();
     new_hash.decrement();
     new_hash.change_state(move.colour - 1, move.pos.index());
-    auto it = cached_order_nodes.find(new_hash);
-    if (it != cached_order_nodes.end()) {
-        if (!it->second.expired()) {
-            auto ptr = it->second.lock();
-            ptr->add_parent(parent, move);
 
-            //std::cerr << "found cached order node with " << ptr->total_visits << " visits !\n";
-
-            return ptr;
-        }
-    } else it = cached_order_nodes.emplace(new_hash, std::weak_ptr<OrderNode>()).first;
-    auto new_node = order_node_buffer.make_shared(parent, move);
-    it->second = new_node;
-    return new_node;
+    return order_table->find_or_create(new_hash, [this, &parent, &move] { return order_arena->create(parent, move); });
 }
 
-std::shared_ptr<ChaosNode> SearchEnvironment::get_chaos_node(OrderNode *parent, const OrderMove &move) {
-    auto new_hash = parent->board.get_hash();
+NodeIndex SearchEnvironment::get_chaos_node(const OrderNode &parent, const OrderMove &move) {
+    auto new_hash = parent.board.get_hash();
     if (!move.is_pass()) {
-        auto type = parent->board.get_minimal_state().read_chip(move.from.row(), move.from.column());
+        auto type = parent.board.get_minimal_state().read_chip(move.from.row(), move.from.column()) - 1;
         new_hash.change_state(type, move.from.index());
         new_hash.change_state(type, move.to.index());
     }
-    auto it = cached_chaos_nodes.find(new_hash);
-    if (it != cached_chaos_nodes.end()) {
-        if (auto ptr = it->second.lock()) {
-            ptr->add_parent(parent, move);
-            return ptr;
+
+    return chaos_table->find_or_create(new_hash, [this, &parent, &move] { return chaos_arena->create(parent, move); });
+}
+
+template <typename Node>
+inline void report_transposition_table(const char *name, TranspositionTable<Node> &table) {
+    const auto statistics = table.statistics();
+    std::cerr << name << " table: hit rate = " << statistics.hit_rate() * 100 << "% of " << statistics.lookups
+              << "; collisions = " << statistics.collisions << "; occupancy = " << statistics.occupancy() * 100 << "%\n";
+    table.reset_statistics();
+}
+
+inline void report_arena(const char *name, const NodeArenaStatistics &statistics) {
+    std::cerr << name << " nodes: live = " << statistics.live << "; peak = " << statistics.peak << "; free = " << statistics.free
+              << "; failed = " << statistics.failed << "; reserved = " << (statistics.reserved_bytes >> 20) << "MiB\n";
+}
+
+void SearchEnvironment::report_statistics() {
+    report_arena("order", order_arena->statistics());
+    report_arena("chaos", chaos_arena->statistics());
+    report_transposition_table("order", *order_table);
+    report_transposition_table("chaos", *chaos_table);
+
+    std::cerr << "solver: iterations = " << solver_statistics.iterations << "; proven hits = " << solver_statistics.proven_hits
+              << "; saved iterations = " << solver_statistics.saved_iterations << '\n';
+    solver_statistics = {};
+}
+
+// Nodes are only released between searches, never while another thread may reach them
+void SearchEnvironment::release_order_node(NodeIndex index) {
+    if (!order_arena->remove_reference(index)) return;
+
+    const auto &node = order_node(index);
+    for (uint i = 0; i < node.published; ++i) release_chaos_node(node.edges[i].node);
+    if (node.amaf != NULL_NODE) release_order_amaf(node.amaf);
+    order_arena->destroy(index);
+}
+
+void SearchEnvironment::release_chaos_node(NodeIndex index) {
+    if (!chaos_arena->remove_reference(index)) return;
+
+    for (NodeIndex edges : chaos_node(index).colour_edges) {
+        if (edges != NULL_NODE) release_chaos_edges(edges);
+    }
+    chaos_arena->destroy(index);
+}
+
+void SearchEnvironment::release_chaos_edges(NodeIndex index) {
+    const auto &edges = chaos_edges(index);
+    for (uint i = 0; i < edges.published; ++i) release_order_node(edges.edges[i].node);
+    if (edges.amaf != NULL_NODE) release_chaos_amaf(edges.amaf);
+
+    static_cast<void>(chaos_edges_arena->remove_reference(index));
+    chaos_edges_arena->destroy(index);
+}
+
+void SearchEnvironment::release_order_amaf(NodeIndex index) {
+    static_cast<void>(order_amaf_arena->remove_reference(index));
+    order_amaf_arena->destroy(index);
+}
+
+void SearchEnvironment::release_chaos_amaf(NodeIndex index) {
+    static_cast<void>(chaos_amaf_arena->remove_reference(index));
+    chaos_amaf_arena->destroy(index);
+}
+
+template <typename Move>
+struct RootChildStatistics {
+    Move move;
+    uint visits;
+    uint score;
+};
+
+template <typename HelperSearch, typename Iteration, typename Solved>
+void SearchEnvironment::root_parallel_search(HelperSearch &&helper_search, Iteration &&iteration, Solved &&solved) {
+    std::vector<std::thread> helpers;
+    helpers.reserve(threads - 1);
+
+    for (uint t = 0; t + 1 < threads; ++t) {
+        const FastRand::result_type seed = RNG() << 16 ^ RNG();
+        helpers.emplace_back([this, t, seed, &helper_search] {
+            RNG.seed = seed;
+            SearchSettings settings = *this;
+            settings.rollouts = thread_rollouts();
+            settings.threads = 1;
+            SearchEnvironment helper{settings};
+            helper.move_values = move_values;
+            helper_search(helper, t);
+        });
+    }
+
+    solver_statistics += search_loop(thread_rollouts(), iteration, solved);
+
+    for (auto &helper : helpers) helper.join();
+}
+
+template <typename Solved>
+void SearchEnvironment::root_parallel_order(OrderNode &root, Solved &&solved) {
+    std::vector<std::vector<RootChildStatistics<OrderMove>>> results(threads - 1);
+
+    root_parallel_search(
+            [&root, &results](SearchEnvironment &helper, uint index) {
+                auto &helper_root = helper.order_node(helper.order_arena->create(root.board, root.pool));
+                helper.tree_search_order(helper_root);
+
+                for (uint i = 0; i < helper_root.published; ++i) {
+                    results[index].push_back({helper_root.edges[i].move.create(), helper_root.statistics.visits(i),
+                                              helper_root.statistics.score_sum(i)});
+                }
+            },
+            [this, &root] { return tree_search_helper(&root); }, solved);
+
+    for (const auto &result : results) {
+        for (const auto &[move, visits, score] : result) {
+            const uint8_t slot = root.edge_slots[order_edge_key(move)];
+            if (slot == NO_EDGE) continue;// the main tree ran out of node memory before expanding it
+
+            auto &child = chaos_node(root.edges[slot].node);
+            child.total_visits += visits;
+            child.total_score += score;
+            root.statistics.add(slot, visits, score);
+
+            root.total_visits += visits;
+            root.total_score += score;
         }
-    } else it = cached_chaos_nodes.emplace(new_hash, std::weak_ptr<ChaosNode>()).first;
-    auto new_node = chaos_node_buffer.make_shared(parent, move);
-    it->second = new_node;
-    return new_node;
+    }
 }
 
-void SearchEnvironment::tree_search_order(OrderNode &root) {
-    root.try_init();
+template <typename Solved>
+void SearchEnvironment::root_parallel_chaos(ChaosNode &root, Colour c, Solved &&solved) {
+    std::vector<std::vector<RootChildStatistics<ChaosMove>>> results(threads - 1);
+
+    root_parallel_search(
+            [&root, &results, c](SearchEnvironment &helper, uint index) {
+                auto &helper_root = helper.chaos_node(helper.chaos_arena->create(root.board, root.pool));
+                helper.tree_search_chaos(helper_root, c);
+
+                const auto &edges = helper.chaos_edges(helper_root.colour_edges[c - 1]);
+                for (uint i = 0; i < edges.published; ++i) {
+                    results[index].push_back({{edges.edges[i].move, c}, edges.statistics.visits(i), edges.statistics.score_sum(i)});
+                }
+            },
+            [this, &root, c] { return tree_search_helper(nullptr, &root, c); }, solved);
+
+    for (const auto &result : results) {
+        for (const auto &[move, visits, score] : result) {
+            auto edges = root.get_edges(c, *this);
+            const uint8_t slot = edges ? edges->edge_slots[move.pos.p] : NO_EDGE;
+            if (slot == NO_EDGE) continue;
+
+            auto &child = order_node(edges->edges[slot].node);
+            child.total_visits += visits;
+            child.total_score += score;
+            edges->statistics.add(slot, visits, score);
+
+            root.colour_entries[c - 1].fetch_add(pack_visits(visits, score), std::memory_order_relaxed);
+            root.total_visits += visits;
+            root.total_score += score;
+        }
+    }
+}
+
+template <typename Iteration, typename Solved>
+void SearchEnvironment::tree_parallel_search(Iteration &&iteration, Solved &&solved) {
+    const uint limit = thread_rollouts();
 
-    while (root.can_add_child()) {
-        auto child = root.add_random_child(*this);
-        auto score = child->rollout();
+    std::vector<std::thread> helpers;
+    std::vector<SolverStatistics> results(threads - 1);
+    helpers.reserve(threads - 1);
 
-        root.record_score(score);
-        child->record_score(score, 0);
+    for (uint t = 0; t + 1 < threads; ++t) {
+        const FastRand::result_type seed = RNG() << 16 ^ RNG();
+        helpers.emplace_back([this, t, seed, limit, &iteration, &solved, &results] {
+            RNG.seed = seed;
+            results[t] = search_loop(limit, iteration, solved);
+        });
     }
 
-    for (uint i = 0; i < rollouts; ++i) {
-        tree_search_helper(&root);
+    solver_statistics += search_loop(limit, iteration, solved);
+
+    for (auto &helper : helpers) helper.join();
+    for (const auto &result : results) solver_statistics += result;
+}
+
+void SearchEnvironment::record_proven_root(Clock::time_point start, std::size_t iterations) {
+    if (deadline == Clock::time_point::max()) {
+        solver_statistics.saved_iterations += rollouts - std::min<std::size_t>(iterations, rollouts);
+        return;
     }
+
+    const auto now = Clock::now();
+    if (now < deadline && now > start) solver_statistics.saved_iterations += std::size_t(double(iterations) * double((deadline - now).count()) / double((now - start).count()));
+}
+
+void SearchEnvironment::tree_search_order(OrderNode &root) {
+    root.try_init(*this);
+
+    const auto start = Clock::now();
+    const std::size_t iterations = solver_statistics.iterations;
+    const auto solved = [this, &root] { return root.try_solve(*this); };
+
+    uint score;
+    while (root.try_add_child(*this, score)) root.record_score(score);
+
+    if (threads > 1 && parallelism == Parallelism::ROOT) root_parallel_order(root, solved);
+    else if (threads > 1) tree_parallel_search([this, &root] { return tree_search_helper(&root); }, solved);
+    else solver_statistics += search_loop(rollouts, [this, &root] { return tree_search_helper(&root); }, solved);
+
+    if (solved()) record_proven_root(start, solver_statistics.iterations - iterations);
 }
 
 void SearchEnvironment::tree_search_chaos(ChaosNode &root, Colour c) {
     if (root.is_terminal()) return;
-    root.try_init();
 
-    while (root.can_add_child(c)) {
-        auto child = root.add_random_child(c, *this);
-        auto score = child->rollout();
+    const auto start = Clock::now();
+    const std::size_t iterations = solver_statistics.iterations;
+    const auto solved = [this, &root, c] { return root.try_solve(c, *this); };
+
+    uint score;
+    while (root.try_add_child(c, *this, score)) root.record_score(score, c);
+
+    if (threads > 1 && parallelism == Parallelism::ROOT) root_parallel_chaos(root, c, solved);
+    else if (threads > 1) tree_parallel_search([this, &root, c] { return tree_search_helper(nullptr, &root, c); }, solved);
+    else solver_statistics += search_loop(rollouts, [this, &root, c] { return tree_search_helper(nullptr, &root, c); }, solved);
+
+    if (solved()) record_proven_root(start, solver_statistics.iterations - iterations);
+}
 
-        root.record_score(score, c);
-        child->record_score(score);
+void SearchEnvironment::ponder(OrderNode &root, const std::atomic<bool> &stop) {
+    root.try_init(*this);
+
+    uint score;
+    for (uint i = 0; i < rollouts && !stop && !root.try_solve(*this); ++i) {
+        if (root.try_add_child(*this, score)) root.record_score(score);
+        else tree_search_helper(&root);
     }
+}
+
+void SearchEnvironment::ponder(ChaosNode &root, const std::atomic<bool> &stop) {
+    if (root.is_terminal()) return;
 
-    for (uint i = 0; i < rollouts; ++i) {
-        tree_search_helper(root.select_child(c, uct_temperature), &root, c);
+    uint score;
+    for (uint i = 0; i < rollouts && !stop && !root.try_solve(*this); ++i) {
+        const Colour c = next_colour(root);
+        if (root.try_add_child(c, *this, score)) root.record_score(score, c);
+        else tree_search_helper(nullptr, &root, c);
     }
 }
 
-inline void SearchEnvironment::tree_search_helper(OrderNode *order_node, ChaosNode *chaos_root, Colour root_colour) {
-    OrderNode *order_nodes[BOARD_AREA]{order_node};
-    ChaosNode *chaos_nodes[BOARD_AREA]{chaos_root};
-    Colour colour_sequence[BOARD_AREA]{root_colour};
+inline bool SearchEnvironment::tree_search_helper(OrderNode *order_root, ChaosNode *chaos_root, Colour root_colour) {
+    OrderNode *order_nodes[BOARD_AREA + 1]{order_root};
+    ChaosNode *chaos_nodes[BOARD_AREA + 1]{chaos_root};
+    Colour colour_sequence[BOARD_AREA + 1]{root_colour};
+
+    // Edges taken from order_nodes[i] to chaos_nodes[i + 1], and from chaos_nodes[i] to order_nodes[i]
+    uint order_slots[BOARD_AREA + 1];
+    ChaosEdges *chaos_edges[BOARD_AREA + 1]{};
+    uint chaos_slots[BOARD_AREA + 1];
+
+    // The moves of the iteration for the all-moves-as-first statistics and the move values, the ones from order_nodes[i]
+    // and chaos_nodes[i] on begin at order_first[i] and chaos_first[i]. Only kept when one of them is on.
+    SimulationMoves moves;
+    SimulationMoves *const recorded_moves = rave || mast ? &moves : nullptr;
+    uint order_first[BOARD_AREA + 1], chaos_first[BOARD_AREA + 1]{};
+
+    const bool virtual_loss = shares_tree();
+    if (chaos_root) {
+        uint rollout_score;
+        if (chaos_root->try_add_child(root_colour, *this, rollout_score, recorded_moves)) {// progressive widening at the root
+            chaos_root->record_score(rollout_score, root_colour);
+            if (rave) chaos_root->get_edges(root_colour, *this)->record_amaf(*this, moves, 0, root_colour, rollout_score);
+            if (mast) move_values->record(moves, rollout_score);
+            return false;
+        }
+
+        const uint slot = chaos_root->select_edge(root_colour, *this);
+        if (slot == NO_EDGE) {// only when the node memory ran out before the root was expanded, or it is proven
+            const bool proven = chaos_root->try_solve(root_colour, *this);
+            chaos_root->record_score(proven ? chaos_root->get_edges(root_colour, *this)->solved.score() : chaos_root->rollout(leaf_rollouts, rollout_chips, nullptr, rollout_policy()), root_colour);
+            return proven;
+        }
+        chaos_edges[0] = chaos_root->get_edges(root_colour, *this);
+        chaos_slots[0] = slot;
+        order_nodes[0] = &order_node(chaos_edges[0]->edges[slot].node);
+        if (virtual_loss) ++chaos_edges[0]->statistics.virtual_visits[slot];
+        if (recorded_moves) moves.add(ChaosMove{chaos_edges[0]->edges[slot].move, root_colour});
+    }
 
     std::size_t depth = 0;
     uint rollout_score;
+    bool proven = false;
 
     while (true) {
-        order_nodes[depth]->try_init();
-        if (order_nodes[depth]->can_add_child()) {
-            rollout_score = order_nodes[depth]->add_random_child(*this)->rollout();
+        auto order_parent = order_nodes[depth];
+        if (recorded_moves) order_first[depth] = moves.order_count;
+        order_parent->try_init(*this);
+        if (order_parent->try_solve(*this)) {
+            rollout_score = order_parent->solved.score();
+            proven = true;
             break;
         }
-        chaos_nodes[depth + 1] = order_nodes[depth]->select_child(uct_temperature);
+        if (order_parent->try_add_child(*this, rollout_score, recorded_moves)) break;
 
-        ++depth;
+        const uint order_slot = order_parent->select_edge(*this);
+        if (order_slot == NO_EDGE) {// every move is taken, but no unproven child is published yet by the other threads
+            rollout_score = order_parent->rollout(leaf_rollouts, rollout_chips, recorded_moves, rollout_policy());
+            break;
+        }
+        if (virtual_loss) ++order_parent->statistics.virtual_visits[order_slot];
+        order_slots[depth] = order_slot;
+        if (recorded_moves) moves.add(order_parent->edges[order_slot].move);
+        auto chaos_parent = chaos_nodes[++depth] = &chaos_node(order_parent->edges[order_slot].node);
+        if (recorded_moves) chaos_first[depth] = moves.chaos_count;
+
+        if (chaos_parent->try_solve(*this)) {
+            rollout_score = chaos_parent->solved.score();
+            proven = true;
+            break;
+        }
 
-        if (chaos_nodes[depth]->is_terminal()) {
-            rollout_score = chaos_nodes[depth]->board.get_total_score();
+        const Colour colour = colour_sequence[depth] = next_colour(*chaos_parent);
+        if (chaos_parent->try_solve(colour, *this)) {
+            rollout_score = chaos_parent->get_edges(colour, *this)->solved.score();
+            proven = true;
             break;
         }
+        if (chaos_parent->try_add_child(colour, *this, rollout_score, recorded_moves)) break;
 
-        chaos_nodes[depth]->try_init();
-        auto random_colour = colour_sequence[depth] = chaos_nodes[depth]->random_colour();
-        if (chaos_nodes[depth]->can_add_child(random_colour)) {
-            rollout_score = chaos_nodes[depth]->add_random_child(random_colour, *this)->rollout();
+        const uint chaos_slot = chaos_parent->select_edge(colour, *this);
+        if (chaos_slot == NO_EDGE) {
+            colour_sequence[depth] = 0;
+            rollout_score = chaos_parent->rollout(leaf_rollouts, rollout_chips, recorded_moves, rollout_policy());
             break;
         }
-        order_nodes[depth] = chaos_nodes[depth]->select_child(random_colour, uct_temperature);
+        auto edges = chaos_edges[depth] = chaos_parent->get_edges(colour, *this);
+        chaos_slots[depth] = chaos_slot;
+        if (virtual_loss) ++edges->statistics.virtual_visits[chaos_slot];
+        if (recorded_moves) moves.add(ChaosMove{edges->edges[chaos_slot].move, colour});
+        order_nodes[depth] = &order_node(edges->edges[chaos_slot].node);
+    }
+
+    // Bottom up, an order node reads the value of its chance child after the child has counted the score
+    for (std::size_t i = depth + 1; i-- > 0;) {
+        if (auto node = order_nodes[i]) {
+            node->record_score(rollout_score);
+            if (i < depth) {
+                node->statistics.record_value(order_slots[i], chaos_nodes[i + 1]->average_score());
+                if (virtual_loss) --node->statistics.virtual_visits[order_slots[i]];
+            }
+        }
+        if (auto node = chaos_nodes[i]) {
+            node->record_score(rollout_score, colour_sequence[i]);
+            if (auto edges = chaos_edges[i]) {
+                edges->statistics.record_score(chaos_slots[i], rollout_score);
+                if (virtual_loss) --edges->statistics.virtual_visits[chaos_slots[i]];
+            }
+        }
+    }
+
+    // Every node on the path counts the score for the moves that its player made from it on, with its own edge among them
+    if (rave) {
+        for (std::size_t i = 0; i <= depth; ++i) {
+            if (auto node = order_nodes[i]) node->record_amaf(*this, moves, order_first[i], rollout_score);
+            if (auto node = chaos_nodes[i]; node && colour_sequence[i]) {
+                if (auto edges = node->get_edges(colour_sequence[i], *this)) {
+                    edges->record_amaf(*this, moves, chaos_first[i], colour_sequence[i], rollout_score);
+                }
+            }
+        }
     }
+    if (mast) move_values->record(moves, rollout_score);
 
-    for (std::size_t i = 0; i <= depth; ++i) {
-        if (order_nodes[i]) order_nodes[i]->record_score(rollout_score);
-        if (chaos_nodes[i]) chaos_nodes[i]->record_score(rollout_score, colour_sequence[i]);
+    // A proven node proves the edge from its parent, which may prove the parent in turn
+    for (std::size_t i = depth + 1; i-- > 0;) {
+        if (auto node = order_nodes[i]) {
+            if (!node->try_solve(*this)) break;
+            if (auto edges = chaos_edges[i]) edges->statistics.prove(chaos_slots[i]);
+        }
+        if (auto node = chaos_nodes[i]) {
+            if (!node->try_solve(*this)) break;
+            if (i) order_nodes[i - 1]->statistics.prove(order_slots[i - 1]);
+        }
     }
+    return proven;
 }
 
-}// namespace entropy::mcts
\ No newline at end of file
+}// namespace entropy::mcts
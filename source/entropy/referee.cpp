@@ -28,6 +28,7 @@ void start_as_chaos(Args &&...args) {
         chaos.register_chaos_move(m);
 
         std::cout << m.pos << std::endl;
+        chaos.start_pondering();
     }
 }
 
@@ -43,6 +44,7 @@ void start_as_order(ChaosMove last_move, Args &&...args) {
         if (m.is_pass()) std::cout << last_move.pos << last_move.pos;
         else std::cout << m.from << m.to;
         std::cout << std::endl;
+        order.start_pondering();
 
         std::cin >> str;
         std::cerr << str << '\n';
@@ -59,8 +61,10 @@ void start_console_game() {
     std::cin >> s;
     std::cerr << s << '\n';
 
-    if (std::isdigit(s[0])) start_as_order<mcts::MoveMaker>({position_from_string(std::string_view(s).substr(1, 2)), Colour(s[0] - '0')});
-    else start_as_chaos<mcts::MoveMaker>();
+    const TimeManager time_manager(GAME_TIME_BUDGET_MS);
+
+    if (std::isdigit(s[0])) start_as_order<mcts::MoveMaker>({position_from_string(std::string_view(s).substr(1, 2)), Colour(s[0] - '0')}, mcts::SearchEnvironment{}, time_manager);
+    else start_as_chaos<mcts::MoveMaker>(mcts::SearchEnvironment{}, time_manager);
 }
 
 }// namespace entropy
\ No newline at end of file
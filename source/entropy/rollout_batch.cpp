@@ -0,0 +1,437 @@
+#include "entropy/rollout_batch.hpp"
+#include "entropy/monte_carlo.hpp"
+
+#include <climits>
+
+// The vector kernels are compiled for their instruction set with function attributes and picked at runtime,
+// so the rest of the program, and the merged submission, keeps building for the baseline target
+#if (defined(__GNUC__) || defined(__clang__)) && defined(__x86_64__)
+#define ENTROPY_SIMD_ROLLOUT
+// The vector helpers are always inlined, so their ABI never matters
+#pragma GCC diagnostic ignored "-Wpsabi"
+#include <immintrin.h>
+#endif
+
+namespace entropy::mcts {
+
+inline uint scalar_rollout_batch(const BoardState &board, const ChipPool &pool, uint n, bool chaos_first) {
+    uint sum = 0;
+    for (uint i = 0; i < n; ++i) sum += chaos_first ? smart_rollout_chaos(board, pool) : smart_rollout_order(board, pool);
+    return sum;
+}
+
+#ifdef ENTROPY_SIMD_ROLLOUT
+
+constexpr inline int32_t SCORE_TABLE_SIZE = sizeof(COMPLETE_SCORE_LOOKUP_TABLE[0]);
+
+// A gather reads 4 bytes, the score of one of the last strings is read from an earlier address and shifted down
+constexpr inline int32_t SCORE_GATHER_LIMIT = SCORE_TABLE_SIZE - 4;
+
+#pragma GCC push_options
+#pragma GCC target("avx2")
+
+struct Avx2 {
+    constexpr static inline uint LANES = 8;
+
+    using Vector = __m256i;
+    using Mask = __m256i;
+
+    static Vector load(const int32_t *p) { return _mm256_load_si256(reinterpret_cast<const Vector *>(p)); }
+
+    static void store(int32_t *p, Vector v) { _mm256_store_si256(reinterpret_cast<Vector *>(p), v); }
+
+    static Vector set1(int32_t x) { return _mm256_set1_epi32(x); }
+
+    static Vector add(Vector a, Vector b) { return _mm256_add_epi32(a, b); }
+
+    static Vector sub(Vector a, Vector b) { return _mm256_sub_epi32(a, b); }
+
+    static Vector mul(Vector a, Vector b) { return _mm256_mullo_epi32(a, b); }
+
+    static Vector bit_and(Vector a, Vector b) { return _mm256_and_si256(a, b); }
+
+    static Vector bit_or(Vector a, Vector b) { return _mm256_or_si256(a, b); }
+
+    static Vector bit_xor(Vector a, Vector b) { return _mm256_xor_si256(a, b); }
+
+    static Vector shift_left(Vector a, uint bits) { return _mm256_sllv_epi32(a, set1(int32_t(bits))); }
+
+    static Vector shift_left(Vector a, Vector bits) { return _mm256_sllv_epi32(a, bits); }
+
+    static Vector shift_right(Vector a, uint bits) { return _mm256_srlv_epi32(a, set1(int32_t(bits))); }
+
+    static Vector shift_right(Vector a, Vector bits) { return _mm256_srlv_epi32(a, bits); }
+
+    static Vector min_unsigned(Vector a, Vector b) { return _mm256_min_epu32(a, b); }
+
+    static Mask equal(Vector a, Vector b) { return _mm256_cmpeq_epi32(a, b); }
+
+    static Mask greater(Vector a, Vector b) { return _mm256_cmpgt_epi32(a, b); }
+
+    static Mask mask_and(Mask a, Mask b) { return _mm256_and_si256(a, b); }
+
+    static Mask mask_or(Mask a, Mask b) { return _mm256_or_si256(a, b); }
+
+    static Mask mask_and_not(Mask a, Mask b) { return _mm256_andnot_si256(b, a); }
+
+    static bool any(Mask m) { return !_mm256_testz_si256(m, m); }
+
+    // Lanes in `m` take `b`, the others keep `a`
+    static Vector select(Mask m, Vector a, Vector b) { return _mm256_blendv_epi8(a, b, m); }
+
+    static Vector gather(const uint8_t *table, Vector index) {
+        return _mm256_i32gather_epi32(reinterpret_cast<const int *>(table), index, 1);
+    }
+};
+
+#pragma GCC pop_options
+
+#pragma GCC push_options
+#pragma GCC target("avx512f")
+
+struct Avx512 {
+    constexpr static inline uint LANES = 16;
+
+    using Vector = __m512i;
+    using Mask = __mmask16;
+
+    static Vector load(const int32_t *p) { return _mm512_load_si512(p); }
+
+    static void store(int32_t *p, Vector v) { _mm512_store_si512(p, v); }
+
+    static Vector set1(int32_t x) { return _mm512_set1_epi32(x); }
+
+    static Vector add(Vector a, Vector b) { return _mm512_add_epi32(a, b); }
+
+    static Vector sub(Vector a, Vector b) { return _mm512_sub_epi32(a, b); }
+
+    static Vector mul(Vector a, Vector b) { return _mm512_mullo_epi32(a, b); }
+
+    static Vector bit_and(Vector a, Vector b) { return _mm512_and_si512(a, b); }
+
+    static Vector bit_or(Vector a, Vector b) { return _mm512_or_si512(a, b); }
+
+    static Vector bit_xor(Vector a, Vector b) { return _mm512_xor_si512(a, b); }
+
+    static Vector shift_left(Vector a, uint bits) { return _mm512_sllv_epi32(a, set1(int32_t(bits))); }
+
+    static Vector shift_left(Vector a, Vector bits) { return _mm512_sllv_epi32(a, bits); }
+
+    static Vector shift_right(Vector a, uint bits) { return _mm512_srlv_epi32(a, set1(int32_t(bits))); }
+
+    static Vector shift_right(Vector a, Vector bits) { return _mm512_srlv_epi32(a, bits); }
+
+    static Vector min_unsigned(Vector a, Vector b) { return _mm512_min_epu32(a, b); }
+
+    static Mask equal(Vector a, Vector b) { return _mm512_cmpeq_epi32_mask(a, b); }
+
+    static Mask greater(Vector a, Vector b) { return _mm512_cmpgt_epi32_mask(a, b); }
+
+    static Mask mask_and(Mask a, Mask b) { return Mask(a & b); }
+
+    static Mask mask_or(Mask a, Mask b) { return Mask(a | b); }
+
+    static Mask mask_and_not(Mask a, Mask b) { return Mask(a & ~b); }
+
+    static bool any(Mask m) { return m; }
+
+    static Vector select(Mask m, Vector a, Vector b) { return _mm512_mask_blend_epi32(m, a, b); }
+
+    static Vector gather(const uint8_t *table, Vector index) { return _mm512_i32gather_epi32(index, table, 1); }
+};
+
+#pragma GCC pop_options
+
+// Playouts of one batch, lane i of every array belongs to playout i.
+// Only the move evaluation is vectorized, drawing the chaos chips and applying the chosen moves is done per lane.
+// The member functions are force inlined into the kernel entry points, which are compiled for the instruction set of S.
+template <typename S>
+class LockstepRollout {
+    using Vector = typename S::Vector;
+    using Mask = typename S::Mask;
+
+    constexpr static inline uint LANES = S::LANES;
+    constexpr static inline int32_t NONE = -1;
+
+    // Best move found so far in every lane, ties are broken by reservoir sampling
+    struct Choice {
+        Vector score;
+        Vector ties;
+        Vector from;
+        Vector to;
+    };
+
+public:
+    [[gnu::always_inline]] LockstepRollout(const BoardState &board, const std::array<uint8_t, BOARD_AREA> &pool_chips) {
+        const auto &state = board.get_minimal_state();
+        for (uint i = 0; i < BOARD_SIZE; ++i) {
+            std::fill_n(horizontal[i], LANES, int32_t(state.get_horizontal_string(i).hash));
+            std::fill_n(vertical[i], LANES, int32_t(state.get_vertical_string(i).hash));
+        }
+        std::fill_n(score, LANES, int32_t(board.get_total_score()));
+        for (uint lane = 0; lane < LANES; ++lane) {
+            chips[lane] = pool_chips;
+            seeds[lane] = int32_t(RNG() << 16 ^ RNG());
+        }
+    }
+
+    [[gnu::always_inline]] void run(uint open_cells, bool chaos_first) {
+        if (chaos_first && open_cells) chaos_move(open_cells--);
+
+        for (; open_cells; --open_cells) {
+            order_move();
+            chaos_move(open_cells);
+        }
+    }
+
+    [[gnu::always_inline]] uint sum(uint lanes) const {
+        uint result = 0;
+        for (uint lane = 0; lane < lanes; ++lane) result += uint(score[lane]);
+        return result;
+    }
+
+private:
+    [[gnu::always_inline]] static Vector lookup(const Vector &strings) {
+        const Vector index = S::min_unsigned(strings, S::set1(SCORE_GATHER_LIMIT));
+        const Vector shift = S::shift_left(S::sub(strings, index), 3);
+        return S::bit_and(S::shift_right(S::gather(COMPLETE_SCORE_LOOKUP_TABLE[0].data(), index), shift), S::set1(0xFF));
+    }
+
+    [[gnu::always_inline]] static Vector cell(const Vector &string, uint i) {
+        return S::bit_and(S::shift_right(string, 3 * i), S::set1(7));
+    }
+
+    [[gnu::always_inline]] static Vector clear_cell(const Vector &string, uint i) {
+        return S::bit_and(string, S::set1(~int32_t(7 << 3 * i)));
+    }
+
+    // 16 uniformly random bits per lane, independent for every draw of a move
+    [[gnu::always_inline]] Vector random() {
+        Vector x = S::add(S::load(seeds), S::set1(int32_t(++draws * 0x9e3779b9u)));
+        x = S::mul(S::bit_xor(x, S::shift_right(x, 16)), S::set1(0x7feb352d));
+        x = S::mul(S::bit_xor(x, S::shift_right(x, 15)), S::set1(int32_t(0x846ca68bu)));
+        return S::shift_right(x, 16);
+    }
+
+    template <bool MAXIMIZE>
+    [[gnu::always_inline]] void choose(Choice &choice, const Mask &candidates, const Vector &score, const Vector &from, const Vector &to) {
+        const Mask better = S::mask_and(candidates, MAXIMIZE ? S::greater(score, choice.score) : S::greater(choice.score, score));
+        const Mask tie = S::mask_and(candidates, S::equal(score, choice.score));
+        if (!S::any(S::mask_or(better, tie))) return;
+
+        const Vector one = S::set1(1);
+        choice.ties = S::select(better, S::select(tie, choice.ties, S::add(choice.ties, one)), one);
+
+        // A tie replaces the choice with probability 1 / ties
+        const Mask replace = S::equal(S::shift_right(S::mul(random(), choice.ties), 16), S::set1(0));
+        const Mask take = S::mask_or(better, S::mask_and(tie, replace));
+
+        choice.score = S::select(better, choice.score, score);
+        choice.from = S::select(take, choice.from, from);
+        choice.to = S::select(take, choice.to, to);
+    }
+
+    [[gnu::always_inline]] void update_line_scores() {
+        for (uint i = 0; i < BOARD_SIZE; ++i) {
+            horizontal_score[i] = lookup(S::load(horizontal[i]));
+            vertical_score[i] = lookup(S::load(vertical[i]));
+        }
+    }
+
+    // Finds the moves of MinimalBoardState::for_each_possible_order_move_with_score by scanning the lines in both directions
+    template <bool LEFT_TO_RIGHT>
+    [[gnu::always_inline]] void order_pass(Choice &choice) {
+        constexpr int STEP = LEFT_TO_RIGHT ? 1 : -1;
+        constexpr uint START = LEFT_TO_RIGHT ? 0 : (BOARD_SIZE - 1);
+
+        const Vector none = S::set1(NONE);
+
+        Vector v_from[BOARD_SIZE], v_colour[BOARD_SIZE], v_moving_str[BOARD_SIZE], h_remove_score[BOARD_SIZE];
+        std::fill_n(v_from, BOARD_SIZE, none);
+
+        for (uint row = START; row < BOARD_SIZE; row += STEP) {
+            const Vector h_str = S::load(horizontal[row]);
+
+            Vector h_from = none, h_colour{}, h_moving_str{}, v_remove_score{};
+
+            for (uint column = START; column < BOARD_SIZE; column += STEP) {
+                const uint p = row * BOARD_SIZE + column;
+                const Vector v_str = S::load(vertical[column]);
+                const Vector c = cell(h_str, column);
+                const Mask empty = S::equal(c, S::set1(0));
+                const Mask filled = S::mask_and_not(S::equal(c, c), empty);
+
+                if (S::any(filled)) {
+                    const Vector pos = S::set1(int32_t(p));
+                    h_from = S::select(filled, h_from, pos);
+                    h_colour = S::select(filled, h_colour, c);
+                    h_moving_str = S::select(filled, h_moving_str, clear_cell(h_str, column));
+                    v_remove_score = S::select(filled, v_remove_score, vertical_remove_score[p]);
+
+                    v_from[column] = S::select(filled, v_from[column], pos);
+                    v_colour[column] = S::select(filled, v_colour[column], c);
+                    v_moving_str[column] = S::select(filled, v_moving_str[column], clear_cell(v_str, row));
+                    h_remove_score[column] = S::select(filled, h_remove_score[column], horizontal_remove_score[p]);
+                }
+
+                const Vector old_score = S::add(horizontal_score[row], vertical_score[column]);
+
+                if (const Mask h = S::mask_and_not(empty, S::equal(h_from, none)); S::any(h)) {
+                    const Vector s = S::add(lookup(S::bit_or(h_moving_str, S::shift_left(h_colour, 3 * column))),
+                                            lookup(S::bit_or(v_str, S::shift_left(h_colour, 3 * row))));
+                    choose<true>(choice, h, S::sub(S::add(v_remove_score, s), old_score), h_from, S::set1(int32_t(p)));
+                }
+                if (const Mask v = S::mask_and_not(empty, S::equal(v_from[column], none)); S::any(v)) {
+                    const Vector s = S::add(lookup(S::bit_or(v_moving_str[column], S::shift_left(v_colour[column], 3 * row))),
+                                            lookup(S::bit_or(h_str, S::shift_left(v_colour[column], 3 * column))));
+                    choose<true>(choice, v, S::sub(S::add(h_remove_score[column], s), old_score), v_from[column], S::set1(int32_t(p)));
+                }
+            }
+        }
+    }
+
+    [[gnu::always_inline]] void order_move() {
+        update_line_scores();
+        for (uint row = 0; row < BOARD_SIZE; ++row) {
+            const Vector h_str = S::load(horizontal[row]);
+            for (uint column = 0; column < BOARD_SIZE; ++column) {
+                const Vector v_str = S::load(vertical[column]);
+                horizontal_remove_score[row * BOARD_SIZE + column] = S::sub(lookup(clear_cell(h_str, column)), horizontal_score[row]);
+                vertical_remove_score[row * BOARD_SIZE + column] = S::sub(lookup(clear_cell(v_str, row)), vertical_score[column]);
+            }
+        }
+
+        // Passing scores 0 and takes part in the tie break
+        Choice choice{S::set1(0), S::set1(1), S::set1(NONE), S::set1(NONE)};
+        order_pass<true>(choice);
+        order_pass<false>(choice);
+
+        alignas(64) int32_t from[LANES], to[LANES];
+        S::store(from, choice.from);
+        S::store(to, choice.to);
+        S::store(score, S::add(S::load(score), choice.score));
+
+        for (uint lane = 0; lane < LANES; ++lane) {
+            if (from[lane] == NONE) continue;
+
+            const uint f_row = from[lane] / BOARD_SIZE, f_column = from[lane] % BOARD_SIZE;
+            const uint t_row = to[lane] / BOARD_SIZE, t_column = to[lane] % BOARD_SIZE;
+            const int32_t colour = horizontal[f_row][lane] >> 3 * f_column & 7;
+
+            horizontal[f_row][lane] &= ~(7 << 3 * f_column);
+            vertical[f_column][lane] &= ~(7 << 3 * f_row);
+            horizontal[t_row][lane] |= colour << 3 * t_column;
+            vertical[t_column][lane] |= colour << 3 * t_row;
+        }
+    }
+
+    [[gnu::always_inline]] void chaos_move(uint open_cells) {
+        alignas(64) int32_t colour[LANES];
+        for (uint lane = 0; lane < LANES; ++lane) {
+            auto it = random_element(chips[lane].begin(), open_cells, RNG);
+            colour[lane] = *it;
+            *it = chips[lane][open_cells - 1];
+        }
+
+        update_line_scores();
+
+        const Vector colours = S::load(colour);
+        Choice choice{S::set1(INT_MAX), S::set1(1), S::set1(NONE), S::set1(NONE)};
+        for (uint row = 0; row < BOARD_SIZE; ++row) {
+            const Vector h_str = S::load(horizontal[row]);
+            for (uint column = 0; column < BOARD_SIZE; ++column) {
+                const Mask empty = S::equal(cell(h_str, column), S::set1(0));
+                if (!S::any(empty)) continue;
+
+                const Vector v_str = S::load(vertical[column]);
+                const Vector s = S::add(lookup(S::bit_or(h_str, S::shift_left(colours, 3 * column))),
+                                        lookup(S::bit_or(v_str, S::shift_left(colours, 3 * row))));
+                const Vector pos = S::set1(int32_t(row * BOARD_SIZE + column));
+                choose<false>(choice, empty, S::sub(s, S::add(horizontal_score[row], vertical_score[column])), pos, pos);
+            }
+        }
+
+        alignas(64) int32_t to[LANES];
+        S::store(to, choice.to);
+        S::store(score, S::add(S::load(score), choice.score));
+
+        for (uint lane = 0; lane < LANES; ++lane) {
+            const uint row = to[lane] / BOARD_SIZE, column = to[lane] % BOARD_SIZE;
+            horizontal[row][lane] |= colour[lane] << 3 * column;
+            vertical[column][lane] |= colour[lane] << 3 * row;
+        }
+    }
+
+    alignas(64) int32_t horizontal[BOARD_SIZE][LANES];
+    alignas(64) int32_t vertical[BOARD_SIZE][LANES];
+    alignas(64) int32_t score[LANES];
+    alignas(64) int32_t seeds[LANES];
+    uint32_t draws = 0;
+
+    std::array<uint8_t, BOARD_AREA> chips[LANES];
+
+    Vector horizontal_score[BOARD_SIZE], vertical_score[BOARD_SIZE];
+    Vector horizontal_remove_score[BOARD_AREA], vertical_remove_score[BOARD_AREA];
+};
+
+template <typename S>
+[[gnu::always_inline]] inline uint lockstep_rollout_batch(const BoardState &board, const ChipPool &pool, uint n, bool chaos_first) {
+    const auto chips = pool.create_array();
+
+    uint sum = 0;
+    for (uint done = 0; done < n; done += S::LANES) {
+        LockstepRollout<S> batch(board, chips);
+        batch.run(board.get_open_cells(), chaos_first);
+        sum += batch.sum(std::min(S::LANES, n - done));
+    }
+    return sum;
+}
+
+[[gnu::target("avx2"), gnu::flatten]] uint avx2_rollout_batch(const BoardState &board, const ChipPool &pool, uint n, bool chaos_first) {
+    return lockstep_rollout_batch<Avx2>(board, pool, n, chaos_first);
+}
+
+// A false positive: the AVX-512 intrinsics of GCC 12 fill their unused merge operand from _mm512_undefined_epi32,
+// which is deliberately uninitialized (`__m512i __Y = __Y;`), and the warning fires once they are flattened in here
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wmaybe-uninitialized"
+[[gnu::target("avx512f"), gnu::flatten]] uint avx512_rollout_batch(const BoardState &board, const ChipPool &pool, uint n, bool chaos_first) {
+    return lockstep_rollout_batch<Avx512>(board, pool, n, chaos_first);
+}
+#pragma GCC diagnostic pop
+
+#endif
+
+RolloutKernel rollout_batch_kernel() {
+    static const RolloutKernel kernel = [] {
+#ifdef ENTROPY_SIMD_ROLLOUT
+        __builtin_cpu_init();
+        if (__builtin_cpu_supports("avx512f")) return RolloutKernel::AVX512;
+        if (__builtin_cpu_supports("avx2")) return RolloutKernel::AVX2;
+#endif
+        return RolloutKernel::SCALAR;
+    }();
+    return kernel;
+}
+
+const char *rollout_kernel_name(RolloutKernel kernel) {
+    switch (kernel) {
+        case RolloutKernel::AVX2: return "AVX2";
+        case RolloutKernel::AVX512: return "AVX-512";
+        default: return "scalar";
+    }
+}
+
+uint rollout_batch(const BoardState &board, const ChipPool &pool, uint n, bool chaos_first) {
+    return rollout_batch(board, pool, n, chaos_first, rollout_batch_kernel());
+}
+
+uint rollout_batch(const BoardState &board, const ChipPool &pool, uint n, bool chaos_first, RolloutKernel kernel) {
+#ifdef ENTROPY_SIMD_ROLLOUT
+    if (kernel == RolloutKernel::AVX512) return avx512_rollout_batch(board, pool, n, chaos_first);
+    if (kernel == RolloutKernel::AVX2) return avx2_rollout_batch(board, pool, n, chaos_first);
+#endif
+    return scalar_rollout_batch(board, pool, n, chaos_first);
+}
+
+}// namespace entropy::mcts
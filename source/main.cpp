@@ -11,7 +11,23 @@ int main(int argc, const char *args[]) {
         start_console_game();
     } else if (argc >= 2) {
         if (!std::strcmp(args[1], "benchmark")) {
-            benchmark_simulated_game();
+            if (argc == 2) benchmark_simulated_game();
+            else if (!std::strcmp(args[2], "root-parallel")) benchmark_parallel_mcts(mcts::Parallelism::ROOT);
+            else if (!std::strcmp(args[2], "tree-parallel")) benchmark_parallel_mcts(mcts::Parallelism::TREE);
+            else if (!std::strcmp(args[2], "ponder")) benchmark_mcts_ponder<5'000, 20>();
+            else if (!std::strcmp(args[2], "rollout-batch")) benchmark_rollout_batch();
+            else if (!std::strcmp(args[2], "uct-selection")) benchmark_uct_selection();
+            else if (!std::strcmp(args[2], "endgame")) benchmark_endgame();
+            else if (!std::strcmp(args[2], "value-function")) benchmark_value_function();
+            else if (!std::strcmp(args[2], "progressive-widening")) benchmark_progressive_widening();
+            else if (!std::strcmp(args[2], "rave")) benchmark_rave();
+            else if (!std::strcmp(args[2], "mast")) benchmark_mast();
+            else if (!std::strcmp(args[2], "stratified-colours")) benchmark_stratified_colours();
+            else if (!std::strcmp(args[2], "bit-board")) benchmark_bit_board();
+            else if (!std::strcmp(args[2], "score-table")) benchmark_score_tables();
+            else if (!std::strcmp(args[2], "placement-delta")) benchmark_placement_deltas();
+            else if (!std::strcmp(args[2], "startup")) benchmark_startup(args[0]);
+            else if (!std::strcmp(args[2], "first-move")) benchmark_first_move();
             //benchmark_mcts_ponder();
             //benchmark_rollout();
         }
@@ -0,0 +1,107 @@
+// Writes opening_book_data.hpp from deep searches of the first moves of a game. Not part of the build by default,
+// enable ENTROPY_OPENING_BOOK_GENERATOR and run it with the path of include/entropy/opening_book_data.hpp.
+//
+// Only the canonical position of each class is searched, see canonical_book_key(): one empty board, 10 cells for
+// the first chip with chaos or order to move and a few hundred pairs of cells for the second reply of order.
+#include "entropy/monte_carlo.hpp"
+#include "entropy/opening_book.hpp"
+
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <vector>
+
+using namespace entropy;
+
+OrderMove::Compact transform(OrderMove::Compact move, uint symmetry) {
+    if (move.is_pass()) return move;
+    return {transform(Position(move.from), symmetry), transform(Position(move.to), symmetry)};
+}
+
+Position search_chaos_move(mcts::SearchEnvironment &environment, const BoardState &board, const ChipPool &pool, Colour colour) {
+    environment.reset();
+    auto &root = environment.chaos_node(environment.chaos_arena->create(board, pool));
+    environment.tree_search_chaos(root, colour);
+    return root.select_best_edge(colour, environment).move;
+}
+
+OrderMove::Compact search_order_move(mcts::SearchEnvironment &environment, const BoardState &board, const ChipPool &pool) {
+    environment.reset();
+    auto &root = environment.order_node(environment.order_arena->create(board, pool));
+    environment.tree_search_order(root);
+    return root.select_best_edge(environment).move;
+}
+
+int main(int argc, const char *args[]) {
+    if (argc < 2 || argc > 3) {
+        std::cerr << "usage: " << args[0] << " <output file> [rollouts per position]\n";
+        return 1;
+    }
+    const uint rollouts = argc == 3 ? uint(std::strtoul(args[2], nullptr, 10)) : 200'000;
+
+    mcts::SearchEnvironment environment{.45, rollouts};
+    std::map<std::uint64_t, std::uint16_t> book;
+
+    // Searches `board` unless its class is already in the book and stores the move mapped onto the canonical image
+    const auto add_position = [&environment, &book](const std::vector<Position::IntType> &cells, const std::vector<Colour> &colours, Colour colour) {
+        BoardState board;
+        ChipPool pool;
+        for (std::size_t i = 0; i < cells.size(); ++i) {
+            board.place_chip({Position(cells[i]), colours[i]});
+            pool = ChipPool(pool, colours[i]);
+        }
+
+        uint symmetry;
+        const std::uint64_t key = canonical_book_key(board, colour, symmetry);
+        if (book.count(key)) return;
+
+        for (auto cell : cells) std::cerr << Position(cell);
+        if (colour) {
+            const Position move = search_chaos_move(environment, board, ChipPool(pool, colour), colour);
+            std::cerr << " chaos " << colour << ": " << move << '\n';
+            book[key] = encode_book_move(transform(move, symmetry));
+        } else {
+            const auto move = search_order_move(environment, board, pool);
+            std::cerr << " order: ";
+            if (move.is_pass()) std::cerr << "PASS\n";
+            else std::cerr << Position(move.from) << Position(move.to) << '\n';
+            book[key] = encode_book_move(transform(move, symmetry));
+        }
+    };
+
+    add_position({}, {}, 1);
+    for (uint a = 0; a < BOARD_AREA; ++a) {
+        add_position({a}, {1}, 0);
+        add_position({a}, {1}, 1);
+        add_position({a}, {1}, 2);
+        for (uint b = a + 1; b < BOARD_AREA; ++b) {
+            add_position({a, b}, {1, 1}, 0);
+            add_position({a, b}, {1, 2}, 0);
+        }
+    }
+
+    std::ofstream out(args[1]);
+    out << "// Generated by source/tools/generate_opening_book.cpp with " << rollouts << " rollouts per position, do not edit\n"
+           "#pragma once\n\n"
+           "#include <array>\n"
+           "#include <cstdint>\n\n"
+           "namespace entropy {\n\n"
+           "// Sorted canonical_book_key() of every book position and its encoded move, see opening_book.hpp\n"
+           "inline constexpr std::array<std::uint64_t, " << book.size() << "> OPENING_BOOK_KEYS{{\n";
+    for (const auto &[key, move] : book) out << "0x" << std::hex << std::setw(16) << std::setfill('0') << key << ",\n";
+    out << std::dec << "}};\n\n"
+           "inline constexpr std::array<std::uint16_t, " << book.size() << "> OPENING_BOOK_MOVES{{\n";
+    uint i = 0;
+    for (const auto &[key, move] : book) out << move << (++i % 16 && i != book.size() ? "," : ",\n");
+    out << "}};\n\n"
+           "}// namespace entropy\n";
+
+    if (!out) {
+        std::cerr << "could not write " << args[1] << '\n';
+        return 1;
+    }
+    std::cerr << book.size() << " book positions\n";
+    return 0;
+}
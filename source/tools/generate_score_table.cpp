@@ -0,0 +1,35 @@
+// Writes a source file that defines COMPLETE_SCORE_LOOKUP_TABLE as constant data,
+// so that the bot does not have to build the table on every start. Used by CMakeLists.txt.
+#include "entropy/board.hpp"
+
+#include <fstream>
+#include <iostream>
+
+int main(int argc, const char *args[]) {
+    using namespace entropy;
+
+    if (argc != 2) {
+        std::cerr << "usage: " << args[0] << " <output file>\n";
+        return 1;
+    }
+
+    std::ofstream out(args[1]);
+    out << "// Generated by source/tools/generate_score_table.cpp, do not edit\n"
+           "#include \"entropy/board.hpp\"\n\n"
+           "namespace entropy {\n\n"
+           "const ScoreLookupTable COMPLETE_SCORE_LOOKUP_TABLE{{{\n";
+
+    const auto &table = COMPLETE_SCORE_LOOKUP_TABLE[0];
+    for (std::size_t i = 0; i < table.size(); ++i) {
+        out << uint(table[i]) << (i % 64 == 63 ? ",\n" : ",");
+    }
+
+    out << "}}};\n\n"
+           "}// namespace entropy\n";
+
+    if (!out) {
+        std::cerr << "could not write " << args[1] << '\n';
+        return 1;
+    }
+    return 0;
+}
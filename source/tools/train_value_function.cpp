@@ -0,0 +1,185 @@
+// Trains the weights of value_function.hpp on self-play games and writes value_function_weights.hpp. Not part of the
+// build by default, enable ENTROPY_VALUE_FUNCTION_TRAINER and run it with the path of
+// include/entropy/value_function_weights.hpp.
+//
+// Every game starts with a random number of chips played by a mix of greedy and random moves, in a proportion that is
+// drawn per game, so that the positions are not only the ones of greedy games. From there both sides follow the greedy
+// rollout policy to the end, and every position with order to move is a sample whose target is the score that the rest
+// of the rollout added. The weights are fitted by normalized stochastic gradient descent on the squared error.
+#include "entropy/value_function.hpp"
+
+#include <cmath>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <vector>
+
+using namespace entropy;
+
+constexpr uint VALIDATION_GAMES = 5'000;
+
+struct Sample {
+    ValueFeatures features;
+    uint score;// score of the board when the sample was taken
+};
+
+void random_order_move(RolloutBoard &board, uint &score, FastRand &gen) {
+    struct {
+        Position from, to;
+        int score;
+    } moves[MAX_POSSIBLE_ORDER_MOVES];
+    uint n = 0;
+    board.for_each_possible_order_move_with_score([&n, &moves](auto from, auto to, int s) { moves[n++] = {from, to, s}; });
+
+    // Passing is one of the moves
+    const uint i = std::uniform_int_distribution<uint>(0, n)(gen);
+    if (i == n) return;
+    board.move_chip(moves[i].from, moves[i].to);
+    score += moves[i].score;
+}
+
+void random_chaos_move(RolloutBoard &board, uint &score, uint open_cells, std::array<uint8_t, BOARD_AREA> &chips, FastRand &gen) {
+    auto chip = random_element(chips.begin(), open_cells, gen);
+    const Colour colour = *chip;
+    *chip = chips[open_cells - 1];
+
+    struct {
+        Position pos;
+        uint score;
+    } moves[BOARD_AREA];
+    uint n = 0;
+    board.for_each_possible_chaos_move_with_score(colour, [&n, &moves](auto p, uint s) { moves[n++] = {p, s}; });
+
+    const auto &move = *random_element(moves, n, gen);
+    board.place_chip(move.pos.row(), move.pos.column(), colour);
+    score += move.score;
+}
+
+// Appends the samples of one game and returns its final score
+uint play_game(std::vector<Sample> &samples, FastRand &gen) {
+    RolloutBoard board{MinimalBoardState{}};
+    auto chips = ChipPool().create_array();
+    uint score = 0;
+    // From greedy to random openings, the tree search reaches both
+    const float exploration = std::uniform_real_distribution<float>()(gen);
+    const auto explore = [&gen, exploration] { return std::uniform_real_distribution<float>()(gen) < exploration; };
+
+    const uint greedy_from = std::uniform_int_distribution<uint>(1, BOARD_AREA - 1)(gen);
+    uint open_cells = BOARD_AREA;
+    for (bool first = true; open_cells; first = false, --open_cells) {
+        const bool greedy = open_cells <= greedy_from;
+        if (greedy) {
+            std::array<uint, BOARD_COLOURS> chip_counts{};
+            for (uint i = 0; i < open_cells; ++i) ++chip_counts[chips[i]];
+            samples.push_back({extract_value_features(board.get_horizontal_strings(), board.get_vertical_strings(), open_cells, chip_counts), score});
+        }
+
+        // Chaos places the first chip of the game
+        if (!first) {
+            if (!greedy && explore()) random_order_move(board, score, gen);
+            else do_smart_order_move(board, score, gen);
+        }
+        if (!greedy && explore()) random_chaos_move(board, score, open_cells, chips, gen);
+        else do_smart_chaos_move(board, score, open_cells, chips, gen);
+    }
+    return score;
+}
+
+template <typename Function>
+void for_each_sample(uint games, FastRand &gen, Function &&f) {
+    std::vector<Sample> samples;
+    for (uint game = 0; game < games; ++game) {
+        samples.clear();
+        const uint final_score = play_game(samples, gen);
+        for (const auto &sample : samples) f(sample.features, float(final_score - sample.score));
+    }
+}
+
+void write_header(const char *path, const ValueWeights &weights, uint games) {
+    std::ofstream out(path);
+    out << "// Generated by source/tools/train_value_function.cpp from " << games << " self-play games, do not edit\n"
+           "#pragma once\n\n"
+           "#include <array>\n\n"
+           "namespace entropy {\n\n"
+           "inline constexpr std::array<float, "
+        << weights.size() << "> VALUE_FUNCTION_WEIGHTS{{\n";
+    out << std::setprecision(6) << std::showpoint;
+    for (uint i = 0; i < weights.size(); ++i) out << weights[i] << (i % 12 == 11 || i + 1 == weights.size() ? "f,\n" : "f,");
+    out << "}};\n\n"
+           "}// namespace entropy\n";
+
+    if (!out) std::cerr << "could not write " << path << '\n';
+}
+
+int main(int argc, const char *args[]) {
+    if (argc < 2 || argc > 4) {
+        std::cerr << "usage: " << args[0] << " <output header> [games] [weights file to continue from and save to]\n";
+        return 1;
+    }
+    const uint games = argc >= 3 ? uint(std::strtoul(args[2], nullptr, 10)) : 200'000;
+
+    ValueWeights weights{};
+    if (argc == 4) {
+        std::ifstream in(args[3], std::ios::binary);
+        if (in && !load_value_weights(in, weights)) {
+            std::cerr << args[3] << " is not a weights file of this layout\n";
+            return 1;
+        }
+    }
+
+    FastRand gen{1};
+    std::vector<Sample> samples;
+    for (uint game = 0; game < games; ++game) {
+        // Decays to a tenth, the targets are single rollouts and the last games have to average out their noise
+        const float rate = 0.05f / (1 + 9 * float(game) / float(games));
+
+        samples.clear();
+        const uint final_score = play_game(samples, gen);
+        for (const auto &sample : samples) {
+            const auto &f = sample.features;
+            const float error = float(final_score - sample.score) - estimate_value_gain(weights, f);
+
+            // Normalized by the squared length of the feature vector: the empty window alone is most of the tuples of
+            // an early position, and a plain step would change the estimate by its count squared
+            std::array<uint, VALUE_STAGE_WEIGHTS> counts{};
+            for (const auto tuple : f.tuples) ++counts[tuple];
+            float norm = 1 + f.same_colour * f.same_colour;
+            for (const auto tuple : f.tuples) norm += float(counts[tuple]);// every count squared once in total
+            const float step = rate * error / norm;
+
+            float *stage = weights.data() + f.stage * VALUE_STAGE_WEIGHTS;
+            for (const auto tuple : f.tuples) stage[tuple] += step;
+            stage[VALUE_BIAS_WEIGHT] += step;
+            stage[VALUE_SAME_COLOUR_WEIGHT] += step * f.same_colour;
+        }
+    }
+
+    // Error of the estimate and of the average gain of the stage on games that were not trained on
+    std::array<double, VALUE_STAGES> squared_error{}, sum{}, squared_sum{};
+    std::array<std::size_t, VALUE_STAGES> count{};
+    FastRand validation_gen{2};
+    for_each_sample(VALIDATION_GAMES, validation_gen, [&](const ValueFeatures &f, float target) {
+        const double error = target - estimate_value_gain(weights, f);
+        squared_error[f.stage] += error * error;
+        sum[f.stage] += target;
+        squared_sum[f.stage] += double(target) * target;
+        ++count[f.stage];
+    });
+
+    std::cerr << "stage  open cells  samples  rmse    stage mean rmse\n";
+    for (uint s = 0; s < VALUE_STAGES; ++s) {
+        const double mean = sum[s] / double(count[s]);
+        std::cerr << std::setw(5) << s << std::setw(6) << s * (BOARD_AREA - 1) / VALUE_STAGES + 1 << '-' << std::setw(2)
+                  << (s + 1) * (BOARD_AREA - 1) / VALUE_STAGES << std::setw(10) << count[s] << std::fixed << std::setprecision(2)
+                  << std::setw(8) << std::sqrt(squared_error[s] / double(count[s])) << std::setw(8)
+                  << std::sqrt(squared_sum[s] / double(count[s]) - mean * mean) << '\n';
+    }
+
+    write_header(args[1], weights, games);
+    if (argc == 4) {
+        std::ofstream out(args[3], std::ios::binary);
+        save_value_weights(out, weights);
+    }
+    return 0;
+}